@@ -6,11 +6,14 @@
 // Changelog:
 //      2019.12.19 Initial version (inherited from https://github.com/semenovf/pfs)
 //      2020.10.26 Changed default_queue_container (ring_buffer_mt now)
+//      2026.10.18 Added processed/dropped counters and busy time.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "pfs/ring_buffer.hpp"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -47,6 +50,11 @@ private:
     queue_container_type _q;
     size_type _capacity_inc {default_capacity_increment};
 
+    // Statistics (see processed_count(), dropped_count(), busy_time())
+    std::atomic<std::uint64_t> _processed {0};
+    std::atomic<std::uint64_t> _dropped {0};
+    std::atomic<std::uint64_t> _busy_ns {0};
+
 public:
     active_queue (size_type capacity_inc = default_capacity_increment)
         : _capacity_inc(capacity_inc != 0 ? capacity_inc : default_capacity_increment)
@@ -85,30 +93,64 @@ public:
     {
         auto result = _q.try_push(active_bind(std::forward<F>(f), std::forward<Args>(args)...)
             , _capacity_inc);
+
+        if (!result)
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+
         assert(result);
     }
 
     void call ()
     {
-        value_type caller;
-
-        if (_q.try_pop(caller)) {
-            caller();
+        if (!this->empty()) {
+            busy_scope scope(*this);
+            call_one();
         }
     }
 
     void call (int max_count)
     {
-        if (max_count > 0) {
+        if (max_count > 0 && !this->empty()) {
+            busy_scope scope(*this);
+
             while (!this->empty() && max_count--)
-                call();
+                call_one();
         }
     }
 
     void call_all ()
     {
-        while (!this->empty())
-            call();
+        if (!this->empty()) {
+            busy_scope scope(*this);
+
+            while (!this->empty())
+                call_one();
+        }
+    }
+
+    /**
+     * @return Number of called items.
+     */
+    std::uint64_t processed_count () const noexcept
+    {
+        return _processed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return Number of items rejected by the queue container (container
+     *         is full and can not grow).
+     */
+    std::uint64_t dropped_count () const noexcept
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return Total time spent in call(), call_all() (items execution).
+     */
+    std::chrono::nanoseconds busy_time () const noexcept
+    {
+        return std::chrono::nanoseconds(_busy_ns.load(std::memory_order_relaxed));
     }
 
     void wait ()
@@ -123,6 +165,39 @@ public:
 
         _q.template wait_for<rep_type, period_type>(std::chrono::microseconds(microseconds));
     }
+
+private:
+    // Busy time is measured once per call()/call_all() invocation rather
+    // than per item
+    class busy_scope
+    {
+        active_queue & _q;
+        std::chrono::steady_clock::time_point _start;
+
+    public:
+        busy_scope (active_queue & q)
+            : _q(q)
+            , _start(std::chrono::steady_clock::now())
+        {}
+
+        ~busy_scope ()
+        {
+            auto elapsed = std::chrono::steady_clock::now() - _start;
+            _q._busy_ns.fetch_add(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+                , std::memory_order_relaxed);
+        }
+    };
+
+    void call_one ()
+    {
+        value_type caller;
+
+        if (_q.try_pop(caller)) {
+            caller();
+            _processed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
 };
 
 } // namespace pfs
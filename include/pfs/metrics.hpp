@@ -0,0 +1,545 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-modulus](https://github.com/semenovf/pfs-modulus) library.
+//
+// Changelog:
+//      2026.10.18 Initial version (metrics registry, Prometheus text exporter).
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cassert>
+
+#if _POSIX_C_SOURCE
+#   include <poll.h>
+#   include <pthread.h>
+#   include <sys/socket.h>
+#   include <sys/un.h>
+#   include <time.h>
+#   include <unistd.h>
+#endif
+
+#if _POSIX_C_SOURCE && !defined(MSG_NOSIGNAL)
+#   define MSG_NOSIGNAL 0
+#endif
+
+namespace pfs {
+
+enum class metric_type
+{
+      counter
+    , gauge
+};
+
+struct metric_sample
+{
+    std::string name;
+    std::string help;
+    metric_type type;
+    std::vector<std::pair<std::string, std::string>> labels;
+    double value;
+};
+
+namespace metrics_details {
+
+inline void append_escaped (std::string & out, std::string const & s, bool quote)
+{
+    for (char c: s) {
+        if (c == '\\')
+            out += "\\\\";
+        else if (c == '\n')
+            out += "\\n";
+        else if (quote && c == '"')
+            out += "\\\"";
+        else
+            out += c;
+    }
+}
+
+inline void append_value (std::string & out, double value)
+{
+    if (std::isnan(value)) {
+        out += "NaN";
+    } else if (std::isinf(value)) {
+        out += value > 0 ? "+Inf" : "-Inf";
+    } else {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.17g", value);
+        out += buf;
+    }
+}
+
+inline char const * type_name (metric_type type)
+{
+    return type == metric_type::counter ? "counter" : "gauge";
+}
+
+} // namespace metrics_details
+
+/**
+ * Registry of metrics sampled on pull. Metric value is provided by getter
+ * (usually reading atomic counter of the measured object), so populating
+ * metrics costs nothing for the measured code.
+ */
+template <typename BasicLockable = std::mutex>
+class metrics_registry
+{
+public:
+    using mutex_type = BasicLockable;
+    using labels_type = std::vector<std::pair<std::string, std::string>>;
+    using getter_type = std::function<double ()>;
+
+private:
+    struct metric_item
+    {
+        std::string name;
+        std::string help;
+        metric_type type;
+        labels_type labels;
+        getter_type getter;
+        void const * owner;
+    };
+
+    mutable mutex_type _mtx;
+    std::vector<metric_item> _metrics;
+
+public:
+    metrics_registry () {}
+    metrics_registry (metrics_registry const &) = delete;
+    metrics_registry & operator = (metrics_registry const &) = delete;
+
+    /**
+     * Registers metric sampled by @a getter on pull. Metrics with the same
+     * @a name must have the same @a type and differ by labels. @a owner
+     * tags metric for bulk removal (see remove()).
+     *
+     * Getter is called with the registry locked, it must not access
+     * the registry.
+     */
+    void add (std::string const & name
+        , metric_type type
+        , std::string const & help
+        , labels_type const & labels
+        , getter_type && getter
+        , void const * owner = nullptr)
+    {
+        std::lock_guard<mutex_type> lock(_mtx);
+        _metrics.push_back(metric_item{name, help, type, labels
+            , std::move(getter), owner});
+    }
+
+    /**
+     * Removes metrics registered by @a owner. Getters are not called after
+     * this method returns, so owner can be destroyed.
+     *
+     * @return Number of removed metrics.
+     */
+    std::size_t remove (void const * owner)
+    {
+        std::lock_guard<mutex_type> lock(_mtx);
+        auto size = _metrics.size();
+
+        _metrics.erase(std::remove_if(_metrics.begin(), _metrics.end()
+            , [owner] (metric_item const & m) { return m.owner == owner; })
+            , _metrics.end());
+
+        return size - _metrics.size();
+    }
+
+    std::size_t size () const
+    {
+        std::lock_guard<mutex_type> lock(_mtx);
+        return _metrics.size();
+    }
+
+    /**
+     * Samples all metrics (pull API). Samples with the same name are
+     * adjacent.
+     */
+    std::vector<metric_sample> snapshot () const
+    {
+        std::vector<metric_sample> result;
+
+        {
+            std::lock_guard<mutex_type> lock(_mtx);
+            result.reserve(_metrics.size());
+
+            for (auto const & m: _metrics)
+                result.push_back(metric_sample{m.name, m.help, m.type, m.labels, m.getter()});
+        }
+
+        std::stable_sort(result.begin(), result.end()
+            , [] (metric_sample const & a, metric_sample const & b) {
+                return a.name < b.name;
+            });
+
+        return result;
+    }
+
+    /**
+     * Samples all metrics into Prometheus text exposition format
+     * (version 0.0.4).
+     */
+    std::string prometheus_text () const
+    {
+        std::string out;
+        auto samples = snapshot();
+        std::string const * prev_name = nullptr;
+
+        for (auto const & s: samples) {
+            if (!prev_name || *prev_name != s.name) {
+                if (!s.help.empty()) {
+                    out += "# HELP ";
+                    out += s.name;
+                    out += ' ';
+                    metrics_details::append_escaped(out, s.help, false);
+                    out += '\n';
+                }
+
+                out += "# TYPE ";
+                out += s.name;
+                out += ' ';
+                out += metrics_details::type_name(s.type);
+                out += '\n';
+                prev_name = & s.name;
+            }
+
+            out += s.name;
+
+            if (!s.labels.empty()) {
+                out += '{';
+
+                for (std::size_t i = 0; i < s.labels.size(); i++) {
+                    if (i > 0)
+                        out += ',';
+
+                    out += s.labels[i].first;
+                    out += "=\"";
+                    metrics_details::append_escaped(out, s.labels[i].second, true);
+                    out += '"';
+                }
+
+                out += '}';
+            }
+
+            out += ' ';
+            metrics_details::append_value(out, s.value);
+            out += '\n';
+        }
+
+        return out;
+    }
+};
+
+/**
+ * CPU time consumed by the thread the meter is attached to. Meter can be
+ * read from any thread, including after the measured thread finished.
+ * Always reports zero on platforms without per-thread CPU clocks.
+ */
+class thread_cpu_meter
+{
+    mutable std::mutex _mtx;
+    bool _attached {false};
+    double _accumulated {0};
+    double _start {0};
+#if _POSIX_C_SOURCE
+    clockid_t _clock;
+#endif
+
+public:
+    class scope
+    {
+        thread_cpu_meter & _meter;
+
+    public:
+        scope (thread_cpu_meter & meter) : _meter(meter) { _meter.attach(); }
+        ~scope () { _meter.detach(); }
+    };
+
+public:
+    thread_cpu_meter () {}
+    thread_cpu_meter (thread_cpu_meter const &) = delete;
+    thread_cpu_meter & operator = (thread_cpu_meter const &) = delete;
+
+    /**
+     * Starts measuring the calling thread.
+     */
+    void attach ()
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        assert(!_attached);
+
+#if _POSIX_C_SOURCE
+        if (pthread_getcpuclockid(pthread_self(), & _clock) != 0)
+            return;
+#endif
+
+        _attached = true;
+        _start = now();
+    }
+
+    /**
+     * Stops measuring, must be called by the measured thread.
+     */
+    void detach ()
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+
+        if (_attached) {
+            _accumulated += now() - _start;
+            _attached = false;
+        }
+    }
+
+    /**
+     * @return CPU time in seconds.
+     */
+    double seconds () const
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        return _attached ? _accumulated + now() - _start : _accumulated;
+    }
+
+private:
+    // Must be called with the meter locked
+    double now () const
+    {
+#if _POSIX_C_SOURCE
+        struct timespec ts;
+
+        if (clock_gettime(_clock, & ts) == 0)
+            return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+#endif
+        return 0;
+    }
+};
+
+/**
+ * Exports registry in Prometheus text format periodically to the file
+ * (e.g. for node_exporter textfile collector) or on request to clients
+ * of the local Unix socket (HTTP/1.0 response, e.g.
+ * `curl --unix-socket PATH http://localhost/metrics`).
+ *
+ * Exporter must be destroyed (or stopped) before the registry.
+ */
+template <typename Registry>
+class metrics_exporter
+{
+    Registry & _registry;
+    std::thread _worker;
+    std::mutex _mtx;
+    std::condition_variable _cv;
+    bool _stop {false};
+
+public:
+    explicit metrics_exporter (Registry & registry)
+        : _registry(registry)
+    {}
+
+    metrics_exporter (metrics_exporter const &) = delete;
+    metrics_exporter & operator = (metrics_exporter const &) = delete;
+
+    ~metrics_exporter ()
+    {
+        stop();
+    }
+
+    bool is_running () const
+    {
+        return _worker.joinable();
+    }
+
+    /**
+     * Writes metrics to @a path. File is replaced atomically (written
+     * into temporary file and renamed).
+     */
+    bool write_file (std::string const & path) const
+    {
+        auto text = _registry.prometheus_text();
+        auto tmp_path = path + ".tmp";
+        auto f = std::fopen(tmp_path.c_str(), "w");
+
+        if (!f)
+            return false;
+
+        bool ok = std::fwrite(text.data(), 1, text.size(), f) == text.size();
+        ok = (std::fclose(f) == 0) && ok;
+
+        if (ok)
+            ok = std::rename(tmp_path.c_str(), path.c_str()) == 0;
+
+        if (!ok)
+            std::remove(tmp_path.c_str());
+
+        return ok;
+    }
+
+    /**
+     * Starts writing metrics to @a path every @a period seconds.
+     *
+     * @return @c false if exporter is already running.
+     */
+    bool start_file (std::string const & path, double period)
+    {
+        if (is_running())
+            return false;
+
+        _stop = false;
+        auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(period));
+
+        _worker = std::thread([this, path, interval] {
+            std::unique_lock<std::mutex> lock(_mtx);
+
+            while (!_stop) {
+                lock.unlock();
+                write_file(path);
+                lock.lock();
+                _cv.wait_for(lock, interval, [this] { return _stop; });
+            }
+        });
+
+        return true;
+    }
+
+    /**
+     * Starts serving metrics on the Unix socket @a path (existing file
+     * is replaced).
+     *
+     * @return @c false if exporter is already running, socket can not be
+     *         created or Unix sockets are not supported.
+     */
+    bool start_unix_socket (std::string const & path)
+    {
+#if _POSIX_C_SOURCE
+        if (is_running())
+            return false;
+
+        struct sockaddr_un addr;
+
+        if (path.size() >= sizeof(addr.sun_path))
+            return false;
+
+        std::memset(& addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (fd < 0)
+            return false;
+
+        ::unlink(path.c_str());
+
+        if (::bind(fd, reinterpret_cast<struct sockaddr *>(& addr), sizeof(addr)) < 0
+                || ::listen(fd, 4) < 0) {
+            ::close(fd);
+            return false;
+        }
+
+        _stop = false;
+
+        _worker = std::thread([this, fd, path] {
+            while (!stopped()) {
+                struct pollfd pfd {fd, POLLIN, 0};
+
+                if (::poll(& pfd, 1, 100) <= 0)
+                    continue;
+
+                int client = ::accept(fd, nullptr, nullptr);
+
+                if (client >= 0) {
+                    serve(client);
+                    ::close(client);
+                }
+            }
+
+            ::close(fd);
+            ::unlink(path.c_str());
+        });
+
+        return true;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    void stop ()
+    {
+        if (!is_running())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _stop = true;
+        }
+
+        _cv.notify_all();
+        _worker.join();
+    }
+
+private:
+    bool stopped ()
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        return _stop;
+    }
+
+#if _POSIX_C_SOURCE
+    // Skips request (any request is answered with metrics)
+    void serve (int client)
+    {
+        char buf[1024];
+        std::string request;
+
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+            struct pollfd pfd {client, POLLIN, 0};
+
+            if (::poll(& pfd, 1, 100) <= 0)
+                break;
+
+            auto n = ::read(client, buf, sizeof(buf));
+
+            if (n <= 0)
+                break;
+
+            request.append(buf, static_cast<std::size_t>(n));
+        }
+
+        auto body = _registry.prometheus_text();
+        std::string response = "HTTP/1.0 200 OK\r\n"
+            "Content-Type: text/plain; version=0.0.4\r\n"
+            "Content-Length: ";
+        response += std::to_string(body.size());
+        response += "\r\n\r\n";
+        response += body;
+
+        std::size_t offset = 0;
+
+        while (offset < response.size()) {
+            auto n = ::send(client, response.data() + offset
+                , response.size() - offset, MSG_NOSIGNAL);
+
+            if (n <= 0)
+                break;
+
+            offset += static_cast<std::size_t>(n);
+        }
+    }
+#endif
+};
+
+} // namespace pfs
@@ -7,9 +7,22 @@
 //      2019.12.19 Initial version (inherited from https://github.com/semenovf/pfs).
 //      2020.01.13 Added support for module configuration (pass user data, application settings).
 //      2020.05.21 Added support for dispatcher-dependent slave modules. (v2.1)
+//      2026.10.18 Added batch detectors (MODULUS_BATCH_DETECTOR).
+//      2026.10.18 Added throttled, debounced and sampled signals.
+//      2026.10.18 Added filtered detectors (MODULUS_FILTERED_DETECTOR).
+//      2026.10.18 Added emission profiling (ProfilingPolicy, profile_snapshot()).
+//      2026.10.18 Added runtime metrics registry (dispatcher::metrics()).
+//      2026.10.18 Added stall watchdog (dispatcher::set_watchdog()).
+//      2026.10.18 Added trace-event labels of emitters, detectors and threads.
+//      2026.10.18 Added non-blocking timer cancellation (cancel_timer()).
+//      2026.10.18 Timer ticks are queued without copying the callback,
+//                 default timer pool reuses nodes.
+//      2026.10.18 Timers are owned by modules (destroyed on finish,
+//                 destroy_timers(), timer_count(), modulus_timers metric).
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "active_queue.hpp"
+#include "metrics.hpp"
 #include "sigslot.hpp"
 #include "timer.hpp"
 #include "pfs/fmt.hpp"
@@ -17,6 +30,7 @@
 #include "pfs/dynamic_library.hpp"
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <deque>
 #include <list>
 #include <map>
@@ -26,6 +40,7 @@
 #include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <cstdio>
 
 #if _POSIX_C_SOURCE
@@ -199,7 +214,7 @@ template <typename T>
 using default_queue_container =  active_queue_details::default_queue_container<T>;
 
 using default_basic_lockable = std::mutex;
-using default_timer_pool = timer_pool<>;
+using default_timer_pool = timer_pool<pooled_timer_associative_container>;
 
 struct default_settings {};
 
@@ -251,7 +266,10 @@ template <bool OldBehaviour = true
         , template <typename> class QueueContainer = default_queue_container
 
         // see [C++ concepts: BasicLockable](http://en.cppreference.com/w/cpp/concept/BasicLockable)>
-        , typename BasicLockable = default_basic_lockable>
+        , typename BasicLockable = default_basic_lockable
+
+        // Emission profiling (see sigslot.hpp), disabled by default
+        , typename ProfilingPolicy = null_profiling_policy>
 struct modulus
 {
     class basic_module;
@@ -266,12 +284,14 @@ struct modulus
     using timer_id = typename timer_pool_type::timer_id;
     using callback_queue_type = active_queue<ActiveQueueFunctionItem, QueueContainer>;
 
-    using sigslot_ns = sigslot<callback_queue_type, BasicLockable>;
+    using sigslot_ns = sigslot<callback_queue_type, BasicLockable, ProfilingPolicy>;
+    using metrics_registry_type = metrics_registry<BasicLockable>;
     using emitter_type  = typename sigslot_ns::template signal<>;
 
     using detector_handler = void (basic_module::*)(void *);
+    using detector_filter = bool (basic_module::*)(void *) const;
     typedef struct { int id; void * emitter; }            emitter_mapper_pair;
-    typedef struct { int id; detector_handler detector; } detector_mapper_pair;
+    typedef struct { int id; detector_handler detector; int max_batch; double linger; detector_filter filter; } detector_mapper_pair;
 
     using module_ctor_t = basic_module * (*)(void);
     using module_dtor_t = void  (*)(basic_module *);
@@ -305,13 +325,127 @@ struct modulus
         return lexical_cast<string_type>(arg) + concat(args...);
     }
 
+    /**
+     * Timer service for timer driven signals (debounced_signal,
+     * sampled_signal) based on dispatcher's timer pool. Callbacks are called
+     * from timer pool's thread.
+     */
+    class timer_service
+    {
+        dispatcher * _pdispatcher {nullptr};
+
+    public:
+        using timer_id = modulus::timer_id;
+
+        timer_service (dispatcher * pdisp) : _pdispatcher(pdisp) {}
+
+        timer_id create (double delay, double period
+            , typename timer_pool_type::callback_type && callback)
+        {
+            return _pdispatcher->acquire_timer(static_cast<basic_module *>(nullptr)
+                , delay, period, std::move(callback));
+        }
+
+        void destroy (timer_id id)
+        {
+            _pdispatcher->destroy_timer(id);
+        }
+    };
+
+    template <typename ...Args>
+    using throttled_signal = typename sigslot_ns::template throttled_signal<Args...>;
+
+    template <typename ...Args>
+    using debounced_signal = typename sigslot_ns::template debounced_signal<timer_service, Args...>;
+
+    template <typename ...Args>
+    using sampled_signal = typename sigslot_ns::template sampled_signal<timer_service, Args...>;
+
     struct detector_pair
     {
         basic_module *   mod;
         detector_handler detector;
+        int              max_batch; // batch detector if greater than zero
+        double           linger;    // batch linger time in seconds
+        detector_filter  filter;    // optional predicate
+
+        detector_pair () : mod(0), detector(0), max_batch(0), linger(0), filter(0) {}
+        detector_pair (basic_module * p, detector_handler d, int max_batch = 0
+                , double linger = 0, detector_filter f = 0)
+            : mod(p), detector(d), max_batch(max_batch), linger(linger), filter(f)
+        {}
+    };
+
+    // Calls detector's filter on the emitter's thread
+    template <typename FilterType>
+    struct detector_filter_caller
+    {
+        basic_module * mod;
+        FilterType filter;
+
+        template <typename ...Ts>
+        bool operator () (Ts const &... args) const
+        {
+            return (mod->*filter)(args...);
+        }
+    };
+
+    /**
+     * Identity of the detector connected to API emitters.
+     */
+    struct detector_info
+    {
+        int         api_id;
+        string_type module_name;
+    };
 
-        detector_pair () : mod(0), detector(0) {}
-        detector_pair (basic_module * p, detector_handler d) : mod(p), detector(d) {}
+    // Progress of the module's event loop observed by watchdog
+    struct loop_state
+    {
+        std::atomic<detector_info const *> current {nullptr};
+        std::atomic<std::uint64_t> handler_seq {0};
+    };
+
+    // Marks detector as currently executed by the event loop
+    class handler_scope
+    {
+        loop_state * _loop;
+        detector_info const * _prev;
+
+    public:
+        handler_scope (loop_state * loop, detector_info const * info)
+            : _loop(loop)
+            , _prev(loop->current.load(std::memory_order_relaxed))
+        {
+            _loop->handler_seq.fetch_add(1, std::memory_order_relaxed);
+            _loop->current.store(info, std::memory_order_release);
+        }
+
+        ~handler_scope ()
+        {
+            _loop->current.store(_prev, std::memory_order_release);
+        }
+    };
+
+    // Calls detector tracked by watchdog
+    template <typename DetectorType>
+    struct detector_caller
+    {
+        basic_module * mod;
+        DetectorType detector;
+        detector_info const * info;
+        loop_state * loop;
+
+        template <typename ...Ts>
+        void operator () (Ts &&... args) const
+        {
+            if (loop) {
+                handler_scope scope(loop, info);
+                (mod->*detector)(std::forward<Ts>(args)...);
+            } else {
+                (mod->*detector)(std::forward<Ts>(args)...);
+            }
+        }
     };
 
     struct module_spec
@@ -355,17 +489,36 @@ struct modulus
         using emitter_mapper_pair = modulus::emitter_mapper_pair;
 
         // MSVC do not want 'detector_mapper_pair' definition in upper level, so duplicate here
-        typedef struct { int id; detector_handler detector; } detector_mapper_pair;
+        typedef struct { int id; detector_handler detector; int max_batch; double linger; detector_filter filter; } detector_mapper_pair;
         //using detector_mapper_pair = modulus::detector_mapper_pair;
 
         using detector_handler = modulus::detector_handler;
+        using detector_filter = modulus::detector_filter;
         using thread_function = typename modulus::thread_function;
 
+        /**
+         * Emitter address for emitter table (see MODULUS_EMITTER). Only plain
+         * signals are accepted, rate limiting adapters are mapped by their
+         * output signal (e.g. `MODULUS_EMITTER(id, emitValue.output())`).
+         */
+        template <typename ...Args>
+        static void * emitter_address (typename sigslot_ns::template signal<Args...> & em) noexcept
+        {
+            return & em;
+        }
+
     protected:
         string_type  _name;
         dispatcher * _pdispatcher = nullptr;
         bool         _started = false;
 
+        // Runtime metrics (see dispatcher::metrics())
+        std::atomic<std::uint64_t> _timer_fires {0};
+        thread_cpu_meter           _cpu_meter;
+
+        // Watchdog state of the module's event loop (async module only)
+        loop_state                 _loop_state;
+
     public:
         void quit ()
         {
@@ -421,6 +574,44 @@ struct modulus
             _pdispatcher->destroy_timer(id);
         }
 
+        /**
+         * Destroy all timers acquired by this module.
+         *
+         * @return Number of destroyed timers.
+         */
+        std::size_t destroy_timers ()
+        {
+            return _pdispatcher->destroy_timers(this);
+        }
+
+        /**
+         * Number of active timers acquired by this module.
+         */
+        std::size_t timer_count () const
+        {
+            return _pdispatcher->timer_count(this);
+        }
+
+        /**
+         * Cancel timer without waiting for its running callback (see
+         * timer_pool::cancel_async()).
+         */
+        inline void cancel_timer (timer_id id
+            , typename timer_pool_type::callback_type && completion
+                = typename timer_pool_type::callback_type{})
+        {
+            _pdispatcher->cancel_timer(id
+                , std::forward<typename timer_pool_type::callback_type>(completion));
+        }
+
+        /**
+         * Timer service for debounced_signal and sampled_signal emitters.
+         */
+        modulus::timer_service * timer_service ()
+        {
+            return & _pdispatcher->_timer_service;
+        }
+
     protected:
         basic_module () noexcept : sigslot_ns::basic_slot_holder()
         {}
@@ -435,6 +626,13 @@ struct modulus
             _name = name;
         }
 
+        // Names thread processing module's queue in recorded trace
+        void set_trace_thread_name ()
+        {
+            if (sigslot_ns::profiling_enabled::value)
+                tracer::instance().set_thread_name(lexical_cast<std::string>(_name));
+        }
+
         virtual bool on_start_wrapper (settings_type const & settings)
         {
             _started = this->on_start(settings);
@@ -453,6 +651,8 @@ struct modulus
                 _pdispatcher->log_warn(concat(_name
                     , string_type(": failed to finalize module")));
             }
+
+            destroy_timers();
         }
 
     public:
@@ -463,6 +663,25 @@ struct modulus
             return _name;
         }
 
+        /**
+         * Event loop executing detectors of this module (@c nullptr for
+         * regular modules, detectors are called by emitter's thread).
+         */
+        loop_state * event_loop_state () noexcept
+        {
+            if (this->use_queued_slots())
+                return & _loop_state;
+
+            if (this->is_slave()) {
+                if (this->master() == _pdispatcher)
+                    return & _pdispatcher->_loop_state;
+
+                return & static_cast<basic_module *>(this->master())->_loop_state;
+            }
+
+            return nullptr;
+        }
+
         bool is_registered () const noexcept
         {
             return _pdispatcher != 0 ? true : false;
@@ -603,6 +822,11 @@ struct modulus
         // Called from dispatcher
         int thread_function_wrapper (settings_type const & settings)
         {
+            // Callback queue is processed by this thread
+            this->set_consumer_thread();
+            this->set_trace_thread_name();
+            thread_cpu_meter::scope cpu_scope(this->_cpu_meter);
+
             // Steps 1, 2, 3
             if (!on_start_wrapper(settings))
                 return dispatcher::exit_status::failure;
@@ -682,6 +906,20 @@ struct modulus
             _slaves.push_back(m);
         }
 
+        /**
+         * Delivers events accumulated by batch detectors of this module
+         * and its slaves if their linger time expired. Custom run() must
+         * call it periodically (before processing the queue) if the module
+         * or its slaves have batch detectors with nonzero linger time.
+         */
+        void flush_all_batches ()
+        {
+            this->flush_batches();
+
+            for (auto slave: _slaves)
+                slave->flush_batches();
+        }
+
         virtual bool on_before_run ()
         {
             return true;
@@ -700,6 +938,7 @@ struct modulus
 
             while (! this->is_quit()) {
                 pqueue->wait_for(wait_period);
+                flush_all_batches();
                 pqueue->call_all();
             }
 
@@ -751,13 +990,32 @@ struct modulus
 ////////////////////////////////////////////////////////////////////////////////
 // SigSlot Mapper
 ////////////////////////////////////////////////////////////////////////////////
+    /**
+     * Emission and delivery statistics of the connection between emitter
+     * and detector (see dispatcher::profile_snapshot()).
+     */
+    struct profile_record
+    {
+        int api_id;
+        string_type emitter;     // Emitter module name
+        string_type detector;    // Detector module name
+        std::uint64_t emissions; // Emissions of the emitter (all detectors)
+        typename sigslot_ns::slot_stats_snapshot delivery;
+    };
+
+    using profile_sequence = SequenceContainer<profile_record>;
+
     struct basic_sigslot_mapper
     {
         virtual ~basic_sigslot_mapper () {}
-        virtual void connect_all () = 0;
+        virtual void connect_all (int api_id, bool watched) = 0;
         virtual void disconnect_all () = 0;
-        virtual void append_emitter (emitter_type * em) = 0;
-        virtual void append_detector (basic_module * m, detector_handler d) = 0;
+        virtual void freeze_all () = 0;
+        virtual void unfreeze_all () = 0;
+        virtual void append_emitter (basic_module * m, emitter_type * em) = 0;
+        virtual void append_detector (basic_module * m, detector_handler d
+            , int max_batch, double linger, detector_filter filter) = 0;
+        virtual void profile_snapshot (int api_id, profile_sequence & records) const = 0;
     };
 
     struct api_item_type
@@ -767,16 +1025,40 @@ struct modulus
         string_type desc;
     };
 
-    template <typename EmitterType, typename DetectorType>
+    template <typename EmitterType, typename DetectorType, typename BatchDetectorType, typename FilterType>
     struct sigslot_mapper : basic_sigslot_mapper
     {
-        using emitter_sequence = SequenceContainer<EmitterType *>;
+        struct emitter_pair
+        {
+            basic_module * mod;
+            EmitterType *  emitter;
+        };
+
+        // Statistics are shared with connections and outlive them
+        struct profile_entry
+        {
+            string_type emitter;
+            string_type detector;
+            std::shared_ptr<typename sigslot_ns::signal_stats> signal_stats;
+            std::shared_ptr<typename sigslot_ns::slot_stats> slot_stats;
+        };
+
+        using emitter_sequence = SequenceContainer<emitter_pair>;
         using detector_sequence = SequenceContainer<detector_pair>;
+        using profile_entry_sequence = SequenceContainer<profile_entry>;
 
         emitter_sequence  emitters;
         detector_sequence detectors;
+        profile_entry_sequence profile_entries;
+
+        // Detector identities reported by watchdog (parallel to detectors)
+        SequenceContainer<std::unique_ptr<detector_info>> detector_infos;
 
-        virtual void connect_all () override
+        /**
+         * Connects emitters to detectors. Detectors are tracked by watchdog
+         * if @a watched is @c true (except batch detectors).
+         */
+        virtual void connect_all (int api_id, bool watched) override
         {
             if (emitters.size() == 0 || detectors.size() == 0)
                 return;
@@ -784,10 +1066,58 @@ struct modulus
             auto last_emitter_it = emitters.cend();
             auto last_detector_it = detectors.cend();
 
+            profile_entries.clear();
+            detector_infos.clear();
+
+            for (auto itd = detectors.cbegin(); itd != last_detector_it; ++itd) {
+                detector_infos.push_back(std::unique_ptr<detector_info>(
+                    new detector_info{api_id, itd->mod->name()}));
+            }
+
             for (auto ite = emitters.cbegin(); ite != last_emitter_it; ++ite) {
-                for (auto itd = detectors.cbegin(); itd != last_detector_it; ++itd) {
-                    EmitterType * em = *ite;
-                    em->connect(itd->mod, reinterpret_cast<DetectorType> (itd->detector));
+                auto itinfo = detector_infos.cbegin();
+
+                for (auto itd = detectors.cbegin(); itd != last_detector_it; ++itd, ++itinfo) {
+                    EmitterType * em = ite->emitter;
+                    typename sigslot_ns::connection_handle h;
+                    loop_state * loop = watched ? itd->mod->event_loop_state() : nullptr;
+
+                    if (itd->max_batch > 0) {
+                        auto linger = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double>(itd->linger));
+                        h = em->connect_batch(itd->mod
+                            , reinterpret_cast<BatchDetectorType> (itd->detector)
+                            , static_cast<std::size_t>(itd->max_batch)
+                            , linger);
+                    } else if (itd->filter && loop) {
+                        h = em->connect(itd->mod
+                            , detector_caller<DetectorType>{itd->mod
+                                , reinterpret_cast<DetectorType> (itd->detector)
+                                , itinfo->get(), loop}
+                            , detector_filter_caller<FilterType>{itd->mod
+                                , reinterpret_cast<FilterType> (itd->filter)});
+                    } else if (itd->filter) {
+                        h = em->connect(itd->mod
+                            , reinterpret_cast<DetectorType> (itd->detector)
+                            , detector_filter_caller<FilterType>{itd->mod
+                                , reinterpret_cast<FilterType> (itd->filter)});
+                    } else if (loop) {
+                        h = em->connect(itd->mod, detector_caller<DetectorType>{itd->mod
+                            , reinterpret_cast<DetectorType> (itd->detector)
+                            , itinfo->get(), loop});
+                    } else {
+                        h = em->connect(itd->mod, reinterpret_cast<DetectorType> (itd->detector));
+                    }
+
+                    if (sigslot_ns::profiling_enabled::value && h) {
+                        profile_entry entry;
+                        entry.emitter = ite->mod->name();
+                        entry.detector = itd->mod->name();
+                        entry.signal_stats = em->stats();
+                        entry.slot_stats = h.stats();
+                        set_trace_labels(typename sigslot_ns::profiling_enabled(), api_id, entry);
+                        profile_entries.push_back(std::move(entry));
+                    }
                 }
             }
         }
@@ -797,19 +1127,77 @@ struct modulus
             auto last = emitters.cend();
 
             for (auto it = emitters.cbegin(); it != last; it++) {
-                EmitterType * em = *it;
+                EmitterType * em = it->emitter;
                 em->disconnect_all();
             }
         }
 
-        virtual void append_emitter (emitter_type * e) override
+        virtual void freeze_all () override
+        {
+            auto last = emitters.cend();
+
+            for (auto it = emitters.cbegin(); it != last; it++) {
+                EmitterType * em = it->emitter;
+                em->freeze();
+            }
+        }
+
+        virtual void unfreeze_all () override
+        {
+            auto last = emitters.cend();
+
+            for (auto it = emitters.cbegin(); it != last; it++) {
+                EmitterType * em = it->emitter;
+                em->unfreeze();
+            }
+        }
+
+        virtual void append_emitter (basic_module * m, emitter_type * e) override
+        {
+            emitters.push_back(emitter_pair{m, reinterpret_cast<EmitterType*>(e)});
+        }
+
+        virtual void append_detector (basic_module * m, detector_handler d
+            , int max_batch, double linger, detector_filter filter) override
         {
-            emitters.push_back(reinterpret_cast<EmitterType*>(e));
+            detectors.push_back(detector_pair(m, d, max_batch, linger, filter));
         }
 
-        virtual void append_detector (basic_module * m, detector_handler d) override
+        virtual void profile_snapshot (int api_id, profile_sequence & records) const override
         {
-            detectors.push_back(detector_pair(m, d));
+            profile_snapshot(typename sigslot_ns::profiling_enabled(), api_id, records);
+        }
+
+    private:
+        void set_trace_labels (std::false_type, int, profile_entry &)
+        {}
+
+        // Spans are named by API identifier, module name is passed as argument
+        void set_trace_labels (std::true_type, int api_id, profile_entry & entry)
+        {
+            auto id = std::to_string(api_id);
+            entry.signal_stats->set_trace_label("emit:" + id
+                , lexical_cast<std::string>(entry.emitter), api_id);
+            entry.slot_stats->set_trace_label("detect:" + id
+                , lexical_cast<std::string>(entry.detector), api_id);
+        }
+
+        void profile_snapshot (std::false_type, int, profile_sequence &) const
+        {}
+
+        void profile_snapshot (std::true_type, int api_id, profile_sequence & records) const
+        {
+            auto last = profile_entries.cend();
+
+            for (auto it = profile_entries.cbegin(); it != last; ++it) {
+                profile_record rec;
+                rec.api_id = api_id;
+                rec.emitter = it->emitter;
+                rec.detector = it->detector;
+                rec.emissions = it->signal_stats->emissions();
+                rec.delivery = it->slot_stats->snapshot();
+                records.push_back(std::move(rec));
+            }
         }
     };
 
@@ -818,7 +1206,9 @@ struct modulus
     {
         using concrete_mapper_type = sigslot_mapper<
                   typename sigslot_ns::template signal<Args...>
-                , void (basic_module::*)(Args...)>;
+                , void (basic_module::*)(Args...)
+                , void (basic_module::*)(typename sigslot_ns::template batch_span<Args...>)
+                , bool (basic_module::*)(Args const &...) const>;
         return static_unique_pointer_cast<basic_sigslot_mapper>(make_unique<concrete_mapper_type>());
     }
 
@@ -830,6 +1220,7 @@ struct modulus
         friend class basic_module;
         friend class module;
         friend class async_module;
+        friend class modulus::timer_service;
 
         using slaves_sequence_type = SequenceContainer<basic_module *>;
 
@@ -845,18 +1236,43 @@ struct modulus
             };
         };
 
+        /**
+         * Watchdog report (see set_watchdog()).
+         */
+        struct stall_report
+        {
+            enum kind_enum {
+                  queue_stalled   // Queue is not drained longer than threshold
+                , handler_overrun // Handler exceeds time budget
+            };
+
+            kind_enum   kind;
+            string_type module;      // Module (or "dispatcher") owning the event loop
+            double      duration;    // Seconds since last progress (lower bound)
+            std::size_t queue_depth;
+            int         api_id;      // API id of executing detector or -1
+            string_type detector;    // Module of executing detector or empty
+        };
+
         typename sigslot_ns::template signal<string_type const &> module_registered;
         typename sigslot_ns::template signal<string_type const &> module_unregistered;
         typename sigslot_ns::template signal<string_type const &> module_started;
 
+        /**
+         * Emitted by watchdog from the timer thread (see set_watchdog()).
+         */
+        typename sigslot_ns::template signal<stall_report const &> module_stalled;
+
     private:
         void connect_all ()
         {
             auto first = _api.begin();
             auto last  = _api.end();
 
+            bool watched = _stall_threshold > 0 || _handler_budget > 0;
+
             for (; first != last; ++first) {
-                first->second->mapper->connect_all();
+                first->second->mapper->connect_all(first->first, watched);
             }
         }
 
@@ -870,6 +1286,26 @@ struct modulus
             }
         }
 
+        void freeze_all ()
+        {
+            auto first = _api.begin();
+            auto last  = _api.end();
+
+            for (; first != last; ++first) {
+                first->second->mapper->freeze_all();
+            }
+        }
+
+        void unfreeze_all ()
+        {
+            auto first = _api.begin();
+            auto last  = _api.end();
+
+            for (; first != last; ++first) {
+                first->second->mapper->unfreeze_all();
+            }
+        }
+
         void unregister_all ()
         {
             _runnable_modules.clear();
@@ -882,6 +1318,8 @@ struct modulus
                 std::shared_ptr<basic_module> & pmodule = modspec.pmodule;
                 log_debug(concat(pmodule->name(), string_type(": unregistered")));
 
+                _metrics.remove(pmodule.get());
+
                 this->module_unregistered(pmodule->name());
 
                 // Need to destroy pmodule before dynamic library will be
@@ -935,6 +1373,10 @@ struct modulus
 
         void finalize (bool was_success_start)
         {
+            // Getters of timer gauges use timer pool, so metrics must not
+            // be sampled while it is destroyed
+            remove_metrics();
+
             // Destroy timer pool
             _ptimer_pool.reset(nullptr);
 
@@ -949,6 +1391,11 @@ struct modulus
             error_printer = & dispatcher::sync_print_error;
 
             if (_module_spec_map.size() > 0) {
+                // Module threads are joined and timer thread (watchdog) is
+                // stopped, no emission is in progress since then
+                if (_frozen_topology)
+                    unfreeze_all();
+
                 auto imodule      = _module_spec_map.begin();
                 auto imodule_last = _module_spec_map.end();
 
@@ -1001,10 +1448,18 @@ struct modulus
          */
         void run ()
         {
+            // Callback queue is processed by this thread
+            this->set_consumer_thread();
+            thread_cpu_meter::scope cpu_scope(_cpu_meter);
+
+            if (sigslot_ns::profiling_enabled::value)
+                tracer::instance().set_thread_name("dispatcher");
+
             auto first = _module_spec_map.begin();
             auto last  = _module_spec_map.end();
 
             bool ok = true;
+            std::vector<basic_module *> slaves;
 
             // 1. Launch `on_start` method for dispatcher's slave modules
             for (; first != last; ++first) {
@@ -1015,6 +1470,8 @@ struct modulus
                     && pmodule->master() == this;
 
                 if (is_dispatcher_slave_module) {
+                    slaves.push_back(pmodule.get());
+
                     if (! pmodule->on_start_wrapper(*_psettings)) {
                         ok = false;
                     } else {
@@ -1041,6 +1498,12 @@ struct modulus
 
             if (OldBehaviour) {
                 while (! _quit_flag) {
+                    // Flush batch detectors with expired linger time
+                    this->flush_batches();
+
+                    for (auto m: slaves)
+                        m->flush_batches();
+
                     if (pqueue->empty()) {
                         std::this_thread::sleep_for(std::chrono::microseconds(100));
                         continue;
@@ -1053,6 +1516,13 @@ struct modulus
                 // New behaviour
                 while (! _quit_flag) {
                     pqueue->wait_for(_wait_period);
+
+                    // Flush batch detectors with expired linger time
+                    this->flush_batches();
+
+                    for (auto m: slaves)
+                        m->flush_batches();
+
                     pqueue->call_all();
                 }
             }
@@ -1088,6 +1558,9 @@ struct modulus
 
                 // And call main module function
                 if (_main_module_ptr->use_queued_slots()) {
+                    _main_module_ptr->set_consumer_thread();
+                    _main_module_ptr->set_trace_thread_name();
+                    thread_cpu_meter::scope cpu_scope(_main_module_ptr->_cpu_meter);
                     r = static_cast<async_module *>(_main_module_ptr)->run();
                 }
 
@@ -1127,6 +1600,7 @@ struct modulus
             _ptimer_pool.reset(new timer_pool_type);
 
             register_api(mapper, n);
+            add_dispatcher_metrics();
         }
 
         virtual ~dispatcher ()
@@ -1154,16 +1628,110 @@ struct modulus
             return _wait_period;
         }
 
+        /**
+         * @brief Freeze API emitters after connecting them in exec().
+         *
+         * @details Frozen emitters do not lock on emission and reject
+         *          further connect/disconnect (see sigslot::signal::freeze()).
+         *          Must be set before exec().
+         */
+        void set_frozen_topology (bool enable) noexcept
+        {
+            _frozen_topology = enable;
+        }
+
+        bool frozen_topology () const noexcept
+        {
+            return _frozen_topology;
+        }
+
+        /**
+         * @brief Returns emission and delivery statistics for each
+         *        connection between API emitters and detectors.
+         *
+         * @details Result is empty if profiling is disabled (see
+         *          ProfilingPolicy). Statistics are collected since exec()
+         *          and remain available after it returns. Delivery time of
+         *          the batch detector is measured per batch.
+         */
+        profile_sequence profile_snapshot () const
+        {
+            profile_sequence result;
+            auto first = _api.begin();
+            auto last  = _api.end();
+
+            for (; first != last; ++first)
+                first->second->mapper->profile_snapshot(first->first, result);
+
+            return result;
+        }
+
+        /**
+         * @brief Runtime metrics of the dispatcher and registered modules.
+         *
+         * @details Metrics labeled by module name:
+         *      - modulus_queue_depth (async modules and dispatcher);
+         *      - modulus_events_processed_total (rate gives events/sec);
+         *      - modulus_events_dropped_total;
+         *      - modulus_handler_seconds_total (time spent in queued
+         *        callbacks);
+         *      - modulus_thread_cpu_seconds_total (async modules and
+         *        dispatcher);
+         *      - modulus_timer_fires_total (all modules and dispatcher);
+         *      - modulus_timers (all modules and dispatcher).
+         *
+         *      Module's metrics are removed on module unregistration,
+         *      metrics of the dispatcher and modules are removed when
+         *      exec() finishes (before timer pool is destroyed).
+         *      Registry may be extended by the application, see also
+         *      metrics_exporter.
+         */
+        metrics_registry_type & metrics () noexcept
+        {
+            return _metrics;
+        }
+
+        metrics_registry_type const & metrics () const noexcept
+        {
+            return _metrics;
+        }
+
+        /**
+         * @brief Enables watchdog for event loops of async modules and
+         *        dispatcher.
+         *
+         * @details Watchdog reports (by log and module_stalled signal) the
+         *          event loop whose queue is not drained for longer than
+         *          @a stall_threshold seconds and the detector executing
+         *          longer than @a handler_budget seconds (API id and module
+         *          of the detector are reported). Zero value disables
+         *          the check. Each stall is reported once.
+         *
+         *          Watchdog runs on the timer pool thread and checks loops
+         *          with a quarter of the smaller interval resolution.
+         *          Must be set before exec().
+         */
+        void set_watchdog (double stall_threshold, double handler_budget = 0)
+        {
+            _stall_threshold = stall_threshold;
+            _handler_budget = handler_budget;
+        }
+
         int exec ()
         {
             int r = exit_status::failure;
 
             connect_all();
 
+            if (_frozen_topology)
+                freeze_all();
+
             auto success_start = start();
 
-            if (success_start)
+            if (success_start) {
+                start_watchdog();
                 r = exec_main();
+            }
 
             finalize(success_start);
 
@@ -1259,7 +1827,8 @@ struct modulus
                     typename api_map_type::iterator it = _api.find(emitter_id);
 
                     if (it != it_end) {
-                        it->second->mapper->append_emitter(reinterpret_cast<emitter_type *>(emitters[i].emitter));
+                        it->second->mapper->append_emitter(pmodule.get()
+                            , reinterpret_cast<emitter_type *>(emitters[i].emitter));
                     } else {
                         log_warn(concat(pmodule->name()
                             , string_type(": emitter '")
@@ -1276,7 +1845,11 @@ struct modulus
                     typename api_map_type::iterator it = _api.find(detector_id);
 
                     if (it != it_end) {
-                        it->second->mapper->append_detector(pmodule.get(), detectors[i].detector);
+                        it->second->mapper->append_detector(pmodule.get()
+                            , detectors[i].detector
+                            , detectors[i].max_batch
+                            , detectors[i].linger
+                            , detectors[i].filter);
                     } else {
                         log_warn(concat(pmodule->name()
                             , string_type(": detector '")
@@ -1288,6 +1861,7 @@ struct modulus
             }
 
             _module_spec_map.insert(std::make_pair(pmodule->name(), modspec));
+            add_module_metrics(pmodule.get());
             log_debug(concat(pmodule->name(), string_type(": registered")));
 
             this->module_registered(pmodule->name());
@@ -1474,42 +2048,335 @@ struct modulus
             return _module_spec_map.size();
         }
 
-        struct timer_callback_helper
+        // Callback of the timer shared with events queued by its ticks.
+        // Slots are owned by dispatcher and reused, so event left in
+        // cleared queue holds its slot until dispatcher is destroyed.
+        struct timer_delivery
         {
             typename timer_pool_type::callback_type callback;
+            std::atomic<int> refs {0};
+            timer_delivery * next_free {nullptr};
+            dispatcher * owner {nullptr};
+
+            void acquire () noexcept
+            {
+                refs.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void release ()
+            {
+                if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    owner->free_delivery(this);
+            }
+        };
+
+        // Queued timer tick. Trivially copyable, so it is stored inside
+        // callback object without allocation.
+        struct timer_delivery_call
+        {
+            timer_delivery * delivery;
+
+            void operator () () const
+            {
+                delivery->callback();
+                delivery->release();
+            }
+        };
+
+        struct timer_callback_helper
+        {
+            timer_delivery * delivery {nullptr};
             basic_module * m {nullptr};
             dispatcher * d {nullptr};
             timer_id timerid {0};
             bool is_single_shot_timer {false};
 
+            timer_callback_helper () = default;
+
+            timer_callback_helper (timer_callback_helper const & other)
+                : delivery(other.delivery)
+                , m(other.m)
+                , d(other.d)
+                , timerid(other.timerid)
+                , is_single_shot_timer(other.is_single_shot_timer)
+            {
+                if (delivery)
+                    delivery->acquire();
+            }
+
+            timer_callback_helper (timer_callback_helper && other) noexcept
+                : delivery(other.delivery)
+                , m(other.m)
+                , d(other.d)
+                , timerid(other.timerid)
+                , is_single_shot_timer(other.is_single_shot_timer)
+            {
+                other.delivery = nullptr;
+            }
+
+            timer_callback_helper & operator = (timer_callback_helper const &) = delete;
+
+            ~timer_callback_helper ()
+            {
+                if (delivery)
+                    delivery->release();
+            }
+
+            // Periodic timer shares its callback with queued ticks instead
+            // of copying it per tick
+            timer_delivery_call queued_call () const
+            {
+                delivery->acquire();
+                return timer_delivery_call{delivery};
+            }
+
             void operator () ()
             {
                 if (m) {
+                    m->_timer_fires.fetch_add(1, std::memory_order_relaxed);
+
                     if (m->use_queued_slots()) {
-                        // Do not std::move callback as it may be periodic
-                        m->callback_queue().push(callback);
+                        m->callback_queue().push(queued_call());
                     } else if (m->is_slave()) {
-                        // Do not std::move callback as it may be periodic
-                        m->master()->callback_queue().push(callback);
+                        m->master()->callback_queue().push(queued_call());
                     } else {
-                        callback();
+                        delivery->callback();
                     }
 
                     if (is_single_shot_timer)
                         m->destroy_timer(timerid);
 
                 } else if (d) {
-                    d->callback_queue().push(callback);
+                    d->_timer_fires.fetch_add(1, std::memory_order_relaxed);
+                    d->callback_queue().push(queued_call());
 
                     if (is_single_shot_timer)
                         d->destroy_timer(timerid);
                 } else {
-                    // NOTE This will never be called in modulus
-                    callback();
+                    // Timer without module (timer_service), callback is
+                    // called directly from timer pool's thread, single
+                    // shot timer is removed by the pool after it returned
+                    delivery->callback();
                 }
             }
         };
 
+        timer_delivery * alloc_delivery (typename timer_pool_type::callback_type && callback)
+        {
+            std::lock_guard<BasicLockable> locker(_delivery_mtx);
+            timer_delivery * delivery = _free_delivery;
+
+            if (delivery) {
+                _free_delivery = delivery->next_free;
+            } else {
+                _deliveries.emplace_back();
+                delivery = & _deliveries.back();
+                delivery->owner = this;
+            }
+
+            delivery->callback = std::move(callback);
+            delivery->refs.store(1, std::memory_order_relaxed);
+            return delivery;
+        }
+
+        void free_delivery (timer_delivery * delivery)
+        {
+            // Captured state is destroyed outside the lock
+            auto callback = std::move(delivery->callback);
+            delivery->callback = nullptr;
+
+            std::lock_guard<BasicLockable> locker(_delivery_mtx);
+            delivery->next_free = _free_delivery;
+            _free_delivery = delivery;
+        }
+
+        void add_queue_metrics (std::string const & name
+            , callback_queue_type const * q
+            , thread_cpu_meter const * cpu_meter
+            , void const * owner)
+        {
+            typename metrics_registry_type::labels_type labels {{"module", name}};
+
+            _metrics.add("modulus_queue_depth", metric_type::gauge
+                , "Number of events waiting in the module's queue"
+                , labels, [q] { return static_cast<double>(q->count()); }, owner);
+
+            _metrics.add("modulus_events_processed_total", metric_type::counter
+                , "Number of events (queued slots and callbacks) processed"
+                , labels, [q] { return static_cast<double>(q->processed_count()); }, owner);
+
+            _metrics.add("modulus_events_dropped_total", metric_type::counter
+                , "Number of events rejected by the module's queue"
+                , labels, [q] { return static_cast<double>(q->dropped_count()); }, owner);
+
+            _metrics.add("modulus_handler_seconds_total", metric_type::counter
+                , "Time spent processing queued events"
+                , labels, [q] {
+                    return std::chrono::duration<double>(q->busy_time()).count();
+                }, owner);
+
+            _metrics.add("modulus_thread_cpu_seconds_total", metric_type::counter
+                , "CPU time of the module's thread"
+                , labels, [cpu_meter] { return cpu_meter->seconds(); }, owner);
+        }
+
+        void add_timer_metrics (std::string const & name
+            , std::atomic<std::uint64_t> const * timer_fires
+            , void const * owner)
+        {
+            _metrics.add("modulus_timer_fires_total", metric_type::counter
+                , "Number of timer callbacks fired"
+                , {{"module", name}}, [timer_fires] {
+                    return static_cast<double>(timer_fires->load(std::memory_order_relaxed));
+                }, owner);
+
+            _metrics.add("modulus_timers", metric_type::gauge
+                , "Number of active timers"
+                , {{"module", name}}, [this, owner] {
+                    return static_cast<double>(timer_count(owner));
+                }, owner);
+        }
+
+        void add_module_metrics (basic_module * m)
+        {
+            auto name = lexical_cast<std::string>(m->name());
+
+            if (m->use_queued_slots())
+                add_queue_metrics(name, & m->callback_queue(), & m->_cpu_meter, m);
+
+            add_timer_metrics(name, & m->_timer_fires, m);
+        }
+
+        void add_dispatcher_metrics ()
+        {
+            add_queue_metrics("dispatcher", & this->callback_queue(), & _cpu_meter, this);
+            add_timer_metrics("dispatcher", & _timer_fires, this);
+        }
+
+        void remove_metrics ()
+        {
+            for (auto const & item: _module_spec_map)
+                _metrics.remove(item.second.pmodule.get());
+
+            _metrics.remove(this);
+        }
+
+        struct watched_loop
+        {
+            basic_module * mod; // nullptr for dispatcher
+            callback_queue_type const * queue;
+            loop_state const * state;
+            std::uint64_t processed;
+            std::chrono::steady_clock::time_point progress_time;
+            bool stall_reported;
+            std::uint64_t handler_seq;
+            std::chrono::steady_clock::time_point handler_since;
+            bool overrun_reported;
+        };
+
+        void start_watchdog ()
+        {
+            _watched_loops.clear();
+
+            if (_stall_threshold <= 0 && _handler_budget <= 0)
+                return;
+
+            auto now = std::chrono::steady_clock::now();
+            _watched_loops.push_back(watched_loop{nullptr, & this->callback_queue()
+                , & _loop_state, 0, now, false, 0, now, false});
+
+            for (auto & item: _module_spec_map) {
+                basic_module * m = item.second.pmodule.get();
+
+                if (m->use_queued_slots()) {
+                    _watched_loops.push_back(watched_loop{m, & m->callback_queue()
+                        , & m->_loop_state, 0, now, false, 0, now, false});
+                }
+            }
+
+            double interval = _stall_threshold <= 0
+                ? _handler_budget
+                : _handler_budget <= 0
+                    ? _stall_threshold
+                    : (std::min)(_stall_threshold, _handler_budget);
+
+            // Timers have millisecond resolution
+            double period = (std::max)(interval / 4, 0.001);
+
+            // Callback is called by the timer thread (not queued), so
+            // stalled dispatcher does not stop the watchdog
+            _ptimer_pool->create(period, period, [this] { check_loops(); });
+        }
+
+        void check_loops ()
+        {
+            auto now = std::chrono::steady_clock::now();
+
+            for (auto & loop: _watched_loops) {
+                auto processed = loop.queue->processed_count();
+                auto depth = loop.queue->count();
+                auto handler = loop.state->current.load(std::memory_order_acquire);
+                auto handler_seq = loop.state->handler_seq.load(std::memory_order_relaxed);
+
+                if (processed != loop.processed || depth == 0) {
+                    loop.processed = processed;
+                    loop.progress_time = now;
+                    loop.stall_reported = false;
+                } else if (_stall_threshold > 0 && !loop.stall_reported
+                        && now - loop.progress_time >= std::chrono::duration<double>(_stall_threshold)) {
+                    loop.stall_reported = true;
+                    report_stall(loop, stall_report::queue_stalled
+                        , now - loop.progress_time, depth, handler);
+                }
+
+                if (handler == nullptr || handler_seq != loop.handler_seq) {
+                    loop.handler_seq = handler_seq;
+                    loop.handler_since = now;
+                    loop.overrun_reported = false;
+                } else if (_handler_budget > 0 && !loop.overrun_reported
+                        && now - loop.handler_since >= std::chrono::duration<double>(_handler_budget)) {
+                    loop.overrun_reported = true;
+                    report_stall(loop, stall_report::handler_overrun
+                        , now - loop.handler_since, depth, handler);
+                }
+            }
+        }
+
+        void report_stall (watched_loop const & loop
+            , typename stall_report::kind_enum kind
+            , std::chrono::steady_clock::duration duration
+            , std::size_t depth
+            , detector_info const * handler)
+        {
+            stall_report report;
+            report.kind = kind;
+            report.module = loop.mod ? loop.mod->name() : string_type("dispatcher");
+            report.duration = std::chrono::duration<double>(duration).count();
+            report.queue_depth = depth;
+            report.api_id = handler ? handler->api_id : -1;
+            report.detector = handler ? handler->module_name : string_type();
+
+            auto msg = concat(string_type(kind == stall_report::queue_stalled
+                    ? "queue is not drained for " : "handler is executing for ")
+                , lexical_cast<string_type>(report.duration)
+                , string_type(" seconds, queue depth: ")
+                , lexical_cast<string_type>(report.queue_depth));
+
+            if (handler) {
+                msg = concat(msg, string_type(", detector: ")
+                    , report.detector
+                    , string_type(", API id: ")
+                    , lexical_cast<string_type>(report.api_id));
+            }
+
+            if (loop.mod)
+                log_warn(loop.mod, msg);
+            else
+                log_warn(concat(report.module, string_type(": "), msg));
+
+            this->module_stalled(report);
+        }
+
         void notify_module_started (bool ok)
         {
             if (!ok)
@@ -1534,9 +2401,13 @@ struct modulus
         {
             timer_callback_helper timer_callback;
             timer_callback.m = m;
-            timer_callback.callback = std::move(callback);
+            timer_callback.delivery = alloc_delivery(std::move(callback));
             timer_callback.is_single_shot_timer = (period == double{0});
-            timer_callback.timerid = _ptimer_pool->create(delay, period, std::move(timer_callback));
+
+            // Timers of the timer service have no owner
+            timer_callback.timerid = m
+                ? _ptimer_pool->create(m, delay, period, std::move(timer_callback))
+                : _ptimer_pool->create(delay, period, std::move(timer_callback));
 
             return timer_callback.timerid;
         }
@@ -1551,9 +2422,10 @@ struct modulus
         {
             timer_callback_helper timer_callback;
             timer_callback.d = this;
-            timer_callback.callback = std::move(callback);
+            timer_callback.delivery = alloc_delivery(std::move(callback));
             timer_callback.is_single_shot_timer = (period == double{0});
-            timer_callback.timerid = _ptimer_pool->create(delay, period, std::move(timer_callback));
+            timer_callback.timerid = _ptimer_pool->create(this, delay, period
+                , std::move(timer_callback));
             return timer_callback.timerid;
         }
 
@@ -1564,6 +2436,29 @@ struct modulus
                 _ptimer_pool->destroy(id);
         }
 
+        /**
+         * Destroy all timers acquired by @a owner (module or dispatcher).
+         */
+        std::size_t destroy_timers (void const * owner)
+        {
+            return _ptimer_pool ? _ptimer_pool->destroy_all(owner) : 0;
+        }
+
+        std::size_t timer_count (void const * owner) const
+        {
+            return _ptimer_pool ? _ptimer_pool->size(owner) : 0;
+        }
+
+        inline void cancel_timer (timer_id id
+            , typename timer_pool_type::callback_type && completion
+                = typename timer_pool_type::callback_type{})
+        {
+            if (_ptimer_pool) {
+                _ptimer_pool->cancel_async(id
+                    , std::forward<typename timer_pool_type::callback_type>(completion));
+            }
+        }
+
     public: // slots
         void log_info (basic_module const * m, string_type const & s)
         {
@@ -1685,16 +2580,45 @@ struct modulus
         basic_module *          _main_module_ptr;
         settings_type *         _psettings {nullptr};
         logger_type *           _plog {nullptr};
+
+        // Timer callbacks, must outlive timer pool (see timer_delivery)
+        BasicLockable           _delivery_mtx;
+        std::deque<timer_delivery> _deliveries;
+        timer_delivery *        _free_delivery {nullptr};
+
         std::unique_ptr<timer_pool_type> _ptimer_pool;
+        modulus::timer_service  _timer_service {this};
+        metrics_registry_type   _metrics;
+        std::atomic<std::uint64_t> _timer_fires {0};
+        thread_cpu_meter        _cpu_meter;
+        loop_state              _loop_state;
+        double                  _stall_threshold {0}; // seconds
+        double                  _handler_budget {0};  // seconds
+        std::vector<watched_loop> _watched_loops;
         intmax_t                _wait_period {10000}; // wait period in microseconds (default is 10 milliseconds)
+        bool                    _frozen_topology {false};
 
     }; // class dispatcher
 }; // struct modulus
 
 } // namespace pfs
 
-#define MODULUS_EMITTER(id, em) { id , reinterpret_cast<void *>(& em) }
-#define MODULUS_DETECTOR(id, dt) { id , reinterpret_cast<detector_handler>(& dt) }
+#define MODULUS_EMITTER(id, em) { id , emitter_address(em) }
+#define MODULUS_DETECTOR(id, dt) { id , reinterpret_cast<detector_handler>(& dt), 0, 0, nullptr }
+
+// Detector with predicate `bool filter (Args const &...) const` called on
+// the emitter's thread, rejected events are not queued to the module
+// (predicate must be thread-safe)
+#define MODULUS_FILTERED_DETECTOR(id, dt, filter)                              \
+    { id , reinterpret_cast<detector_handler>(& dt), 0, 0                      \
+        , reinterpret_cast<detector_filter>(& filter) }
+
+// Batch detector `void dt (batch_span<Args...>)` called with accumulated
+// events (at most max_batch at once, events wait for the batch at most
+// linger seconds plus polling period of the loop checking it, custom
+// async_module::run() must call flush_all_batches())
+#define MODULUS_BATCH_DETECTOR(id, dt, max_batch, linger)                      \
+    { id , reinterpret_cast<detector_handler>(& dt), max_batch, linger, nullptr }
 
 #define MODULUS_DECL_EMITTERS                                                  \
     virtual emitter_mapper_pair const *                                        \
@@ -5,16 +5,478 @@
 //
 // Changelog:
 //      2019.12.19 Initial version (inherited from https://github.com/semenovf/pfs)
+//      2026.10.18 Added rcu_signal (lock-free emission).
+//      2026.10.18 Added frozen topology mode for signal.
+//      2026.10.18 Added support for callable (lambda) slots.
+//      2026.10.18 Added move-only and shared payload argument passing.
+//      2026.10.18 Added same-thread inline delivery for queued slots.
+//      2026.10.18 Added connection handles (O(1) disconnect), slot holder
+//                 tracks connections by intrusive links.
+//      2026.10.18 Added compact_slot_holder.
+//      2026.10.18 Added batched signal emission (emit_batch()).
+//      2026.10.18 Added batch slots (connect_batch()).
+//      2026.10.18 Added throttled, debounced and sampled signals.
+//      2026.10.18 Added connection filters (emitter-side predicates).
+//      2026.10.18 Added emission profiling (ProfilingPolicy).
+//      2026.10.18 Added trace-event recording of emission and delivery.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <set>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "trace.hpp"
 
 namespace pfs {
 
+namespace sigslot_details {
+
+// std::index_sequence is C++14 feature
+template <std::size_t ...I>
+struct index_sequence {};
+
+template <std::size_t N, std::size_t ...I>
+struct make_index_sequence_helper : make_index_sequence_helper<N - 1, N - 1, I...> {};
+
+template <std::size_t ...I>
+struct make_index_sequence_helper<0, I...>
+{
+    using type = index_sequence<I...>;
+};
+
+template <std::size_t N>
+using make_index_sequence = typename make_index_sequence_helper<N>::type;
+
+template <typename ...Ts>
+struct all_copy_constructible : std::true_type {};
+
+template <typename T, typename ...Ts>
+struct all_copy_constructible<T, Ts...> : std::integral_constant<bool
+    , std::is_copy_constructible<typename std::decay<T>::type>::value
+        && all_copy_constructible<Ts...>::value> {};
+
+// Signal arguments stored for deferred (queued) call
+template <typename ...Args>
+using payload = std::tuple<typename std::decay<Args>::type...>;
+
+template <typename SlotHolderClass, typename ...Args>
+struct member_slot
+{
+    SlotHolderClass * pobject;
+    void (SlotHolderClass::* pmemfun)(Args...);
+
+    template <typename ...Ts>
+    void operator () (Ts &&... args) const
+    {
+        (pobject->*pmemfun)(std::forward<Ts>(args)...);
+    }
+};
+
+// Owns arguments, moves them into the slot on call (queue item is called once)
+template <typename Callable, typename ...Args>
+struct payload_invoker
+{
+    Callable callable;
+    payload<Args...> args;
+
+    void operator () ()
+    {
+        invoke(make_index_sequence<sizeof...(Args)>());
+    }
+
+    template <std::size_t ...I>
+    void invoke (index_sequence<I...>)
+    {
+        callable(std::forward<Args>(std::get<I>(args))...);
+    }
+};
+
+// Same as payload_invoker but for move-only arguments: queue item must be
+// copyable, so arguments are kept out of line.
+template <typename Callable, typename ...Args>
+struct moved_payload_invoker
+{
+    Callable callable;
+    std::shared_ptr<payload<Args...>> args;
+
+    void operator () ()
+    {
+        invoke(make_index_sequence<sizeof...(Args)>());
+    }
+
+    template <std::size_t ...I>
+    void invoke (index_sequence<I...>)
+    {
+        callable(std::forward<Args>(std::get<I>(*args))...);
+    }
+};
+
+// Immutable arguments shared by all receivers of the signal
+template <typename Callable, typename ...Args>
+struct shared_payload_invoker
+{
+    Callable callable;
+    std::shared_ptr<payload<Args...> const> args;
+
+    void operator () ()
+    {
+        invoke(make_index_sequence<sizeof...(Args)>());
+    }
+
+    template <std::size_t ...I>
+    void invoke (index_sequence<I...>)
+    {
+        callable(std::get<I>(*args)...);
+    }
+};
+
+// Range of arguments shared by all receivers of the batch, queued receiver
+// gets whole range as single queue item
+template <typename Callable, typename ...Args>
+struct batch_invoker
+{
+    Callable callable;
+    std::shared_ptr<std::vector<payload<Args...>> const> batch;
+
+    void operator () ()
+    {
+        for (auto const & args: *batch)
+            invoke(args, make_index_sequence<sizeof...(Args)>());
+    }
+
+    template <std::size_t ...I>
+    void invoke (payload<Args...> const & args, index_sequence<I...>)
+    {
+        callable(std::get<I>(args)...);
+    }
+};
+
+// Contiguous range of argument tuples passed to batch slot
+template <typename ...Args>
+class batch_span
+{
+public:
+    using value_type = payload<Args...>;
+    using const_iterator = value_type const *;
+
+private:
+    value_type const * _data {nullptr};
+    std::size_t _size {0};
+
+public:
+    batch_span () {}
+    batch_span (value_type const * data, std::size_t size) : _data(data), _size(size) {}
+
+    const_iterator begin () const noexcept { return _data; }
+    const_iterator end () const noexcept { return _data + _size; }
+    value_type const * data () const noexcept { return _data; }
+    std::size_t size () const noexcept { return _size; }
+    bool empty () const noexcept { return _size == 0; }
+    value_type const & operator [] (std::size_t i) const { return _data[i]; }
+};
+
+// Emission counters of the signal (see profiling_policy)
+class signal_stats
+{
+    std::atomic<std::uint64_t> _emissions {0};
+    trace_details::label _trace_label;
+
+public:
+    /**
+     * Sets labels of emission spans recorded by tracer. Must be set before
+     * emission.
+     */
+    void set_trace_label (std::string const & name
+        , std::string const & module = std::string{}, int api_id = -1)
+    {
+        _trace_label = tracer::instance().make_label(name, module, api_id);
+    }
+
+    trace_details::label const & trace_label () const noexcept
+    {
+        return _trace_label;
+    }
+
+    void on_emit (std::uint64_t n = 1) noexcept
+    {
+        _emissions.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    std::uint64_t emissions () const noexcept
+    {
+        return _emissions.load(std::memory_order_relaxed);
+    }
+};
+
+struct slot_stats_snapshot
+{
+    std::uint64_t deliveries {0};
+    std::uint64_t total_ns {0};
+    std::uint64_t max_ns {0};
+    std::uint64_t p50_ns {0}; // Percentiles have power-of-two resolution
+    std::uint64_t p99_ns {0};
+};
+
+// Delivery counters and execution time histogram of the connection
+// (see profiling_policy)
+class slot_stats
+{
+    static constexpr int bucket_count = 64;
+
+    std::atomic<std::uint64_t> _deliveries {0};
+    std::atomic<std::uint64_t> _total_ns {0};
+    std::atomic<std::uint64_t> _max_ns {0};
+    std::atomic<std::uint64_t> _buckets[bucket_count];
+    trace_details::label _trace_label;
+
+public:
+    slot_stats ()
+    {
+        for (auto & b: _buckets)
+            b.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Sets labels of execution spans recorded by tracer. Must be set before
+     * emission.
+     */
+    void set_trace_label (std::string const & name
+        , std::string const & module = std::string{}, int api_id = -1)
+    {
+        _trace_label = tracer::instance().make_label(name, module, api_id);
+    }
+
+    trace_details::label const & trace_label () const noexcept
+    {
+        return _trace_label;
+    }
+
+    void on_delivery (std::chrono::steady_clock::duration elapsed) noexcept
+    {
+        auto ns = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        _deliveries.fetch_add(1, std::memory_order_relaxed);
+        _total_ns.fetch_add(ns, std::memory_order_relaxed);
+        _buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+
+        auto max = _max_ns.load(std::memory_order_relaxed);
+
+        while (ns > max && !_max_ns.compare_exchange_weak(max, ns
+                , std::memory_order_relaxed))
+            ;
+    }
+
+    slot_stats_snapshot snapshot () const noexcept
+    {
+        slot_stats_snapshot result;
+        std::uint64_t counts[bucket_count];
+        std::uint64_t total = 0;
+
+        for (int i = 0; i < bucket_count; i++) {
+            counts[i] = _buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+
+        result.deliveries = _deliveries.load(std::memory_order_relaxed);
+        result.total_ns = _total_ns.load(std::memory_order_relaxed);
+        result.max_ns = _max_ns.load(std::memory_order_relaxed);
+        result.p50_ns = percentile(counts, total, 50);
+        result.p99_ns = percentile(counts, total, 99);
+
+        return result;
+    }
+
+private:
+    static int bucket_index (std::uint64_t ns) noexcept
+    {
+        int i = 0;
+
+        while (ns > 1 && i < bucket_count - 1) {
+            ns >>= 1;
+            ++i;
+        }
+
+        return i;
+    }
+
+    // Upper bound of the bucket containing requested percentile
+    static std::uint64_t percentile (std::uint64_t const * counts
+        , std::uint64_t total, int pct) noexcept
+    {
+        if (total == 0)
+            return 0;
+
+        std::uint64_t rank = (total * pct + 99) / 100;
+        std::uint64_t acc = 0;
+
+        for (int i = 0; i < bucket_count; i++) {
+            acc += counts[i];
+
+            if (acc >= rank)
+                return i < bucket_count - 1 ? (std::uint64_t{1} << (i + 1)) - 1 : ~std::uint64_t{0};
+        }
+
+        return ~std::uint64_t{0};
+    }
+};
+
+// Owner of the statistics, statistics are shared with queue items so they
+// outlive the connection
+template <typename Stats, bool Enabled>
+class stats_holder
+{
+    std::shared_ptr<Stats> _stats {std::make_shared<Stats>()};
+
+public:
+    std::shared_ptr<Stats> stats () const noexcept { return _stats; }
+    Stats * stats_ptr () const noexcept { return _stats.get(); }
+};
+
+template <typename Stats>
+class stats_holder<Stats, false>
+{
+public:
+    std::shared_ptr<Stats> stats () const noexcept { return nullptr; }
+    Stats * stats_ptr () const noexcept { return nullptr; }
+};
+
+// Measures the slot execution time, records execution span if tracer is
+// active. Queued delivery passes flow started at enqueue and enqueue time.
+template <typename Stats, bool Enabled>
+class delivery_scope
+{
+    Stats * _stats;
+    std::chrono::steady_clock::time_point _start;
+    std::int64_t _trace_start {-1};
+    std::int64_t _wait_ns {-1};
+
+public:
+    delivery_scope (Stats * stats, std::uint64_t flow_id = 0
+            , std::int64_t enqueued_ns = -1)
+        : _stats(stats)
+        , _start(std::chrono::steady_clock::now())
+    {
+        auto & t = tracer::instance();
+
+        if (t.is_active()) {
+            _trace_start = t.now();
+
+            if (flow_id != 0)
+                t.record_flow(trace_details::phase::flow_end, flow_id, _trace_start);
+
+            if (enqueued_ns >= 0)
+                _wait_ns = _trace_start - enqueued_ns;
+        }
+    }
+
+    ~delivery_scope ()
+    {
+        _stats->on_delivery(std::chrono::steady_clock::now() - _start);
+
+        if (_trace_start >= 0) {
+            auto & t = tracer::instance();
+            t.record_span("execute", _stats->trace_label(), _trace_start
+                , t.now(), _wait_ns);
+        }
+    }
+};
+
+template <typename Stats>
+class delivery_scope<Stats, false>
+{
+public:
+    delivery_scope (Stats *) {}
+};
+
+// Counts emission, records emission span if tracer is active
+template <typename Stats, bool Enabled>
+class emission_scope
+{
+    Stats * _stats;
+    std::int64_t _trace_start {-1};
+
+public:
+    emission_scope (Stats * stats, std::uint64_t n = 1)
+        : _stats(stats)
+    {
+        _stats->on_emit(n);
+
+        auto & t = tracer::instance();
+
+        if (t.is_active())
+            _trace_start = t.now();
+    }
+
+    ~emission_scope ()
+    {
+        if (_trace_start >= 0) {
+            auto & t = tracer::instance();
+            t.record_span("emit", _stats->trace_label(), _trace_start, t.now());
+        }
+    }
+};
+
+template <typename Stats>
+class emission_scope<Stats, false>
+{
+public:
+    emission_scope (Stats *, std::uint64_t = 1) {}
+};
+
+// Queue item measuring execution time of the wrapped one. If tracer is
+// active flow is started at enqueue and finished at execution, so viewer
+// draws arrow from emission to the execution in consumer thread.
+template <typename Invoker, typename Stats>
+struct profiled_invoker
+{
+    Invoker invoker;
+    std::shared_ptr<Stats> stats;
+    std::uint64_t flow_id;
+    std::int64_t enqueued_ns;
+
+    void operator () ()
+    {
+        delivery_scope<Stats, true> scope(stats.get(), flow_id, enqueued_ns);
+        invoker();
+    }
+};
+
+template <typename Invoker, typename Stats>
+inline Invoker && profile_invoker (Invoker && invoker, stats_holder<Stats, false> const &)
+{
+    return std::forward<Invoker>(invoker);
+}
+
+template <typename Invoker, typename Stats>
+inline profiled_invoker<typename std::decay<Invoker>::type, Stats>
+profile_invoker (Invoker && invoker, stats_holder<Stats, true> const & holder)
+{
+    std::uint64_t flow_id = 0;
+    std::int64_t enqueued_ns = -1;
+    auto & t = tracer::instance();
+
+    if (t.is_active()) {
+        flow_id = t.next_flow_id();
+        enqueued_ns = t.now();
+        t.record_flow(trace_details::phase::flow_start, flow_id, enqueued_ns);
+    }
+
+    return profiled_invoker<typename std::decay<Invoker>::type, Stats>{
+        std::forward<Invoker>(invoker), holder.stats(), flow_id, enqueued_ns};
+}
+
+} // namespace sigslot_details
+
 class fake_active_queue
 {
 public:
@@ -35,334 +497,2481 @@ public:
     void push (F &&, Args &&...) {}
 };
 
-template <typename ActiveQueue = fake_active_queue
-        , typename BasicLockable = std::mutex>
-struct sigslot
-{
-    using callback_queue_type = ActiveQueue;
-    using mutex_type = BasicLockable;
+/**
+ * Profiling policy disabling statistics (default), profiling code is
+ * compiled out.
+ */
+struct null_profiling_policy
+{
+    static constexpr bool enabled = false;
+    struct signal_stats {};
+    struct slot_stats {};
+};
+
+/**
+ * Profiling policy counting emissions per signal, deliveries per connection
+ * and measuring slot execution time (direct, inline and queued delivery).
+ * Emission and execution spans are recorded by tracer (see trace.hpp) while
+ * it is active.
+ */
+struct profiling_policy
+{
+    static constexpr bool enabled = true;
+    using signal_stats = sigslot_details::signal_stats;
+    using slot_stats = sigslot_details::slot_stats;
+};
+
+template <typename ActiveQueue = fake_active_queue
+        , typename BasicLockable = std::mutex
+        , typename ProfilingPolicy = null_profiling_policy>
+struct sigslot
+{
+    using callback_queue_type = ActiveQueue;
+    using mutex_type = BasicLockable;
+    using profiling_policy_type = ProfilingPolicy;
+    using profiling_enabled = std::integral_constant<bool, ProfilingPolicy::enabled>;
+    using signal_stats = typename ProfilingPolicy::signal_stats;
+    using slot_stats = typename ProfilingPolicy::slot_stats;
+    using slot_stats_snapshot = sigslot_details::slot_stats_snapshot;
+    using delivery_scope = sigslot_details::delivery_scope<slot_stats, ProfilingPolicy::enabled>;
+    using emission_scope = sigslot_details::emission_scope<signal_stats, ProfilingPolicy::enabled>;
+
+    template <typename ...Args>
+    using batch_span = sigslot_details::batch_span<Args...>;
+
+    class slot_holder_base;
+    class basic_slot_holder;
+
+    // see [std::make_unique](http://en.cppreference.com/w/cpp/memory/unique_ptr/make_unique)
+    // `Possible Implementation` section.
+    template<typename T, typename ...Args>
+    static inline std::unique_ptr<T> make_unique (Args &&... args)
+    {
+        return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
+    }
+
+    template <typename SignalType, typename ...Args>
+    static inline void emit_signal (SignalType & sig, Args &&... args)
+    {
+        sig.emit_signal(std::forward<Args>(args)...);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// basic_signal
+////////////////////////////////////////////////////////////////////////////////
+    class connection_link;
+    class connection_handle;
+
+    class basic_signal
+        : public mutex_type
+        , public sigslot_details::stats_holder<signal_stats, ProfilingPolicy::enabled>
+    {
+        friend class connection_handle;
+
+    public:
+        virtual ~basic_signal () {}
+
+        // Called by slot holder with the signal's mutex locked to remove
+        // (and destroy) connection already unlinked from the holder
+        virtual void slot_disconnect (connection_link * link) = 0;
+
+        // Removes and destroys connection
+        bool disconnect (connection_link * link)
+        {
+            std::lock_guard<mutex_type> lock(*this);
+            return disconnect_locked(link);
+        }
+
+    protected:
+        // Same as disconnect() but must be called with the signal's mutex
+        // locked
+        virtual bool disconnect_locked (connection_link * link) = 0;
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// connection_link
+////////////////////////////////////////////////////////////////////////////////
+    /**
+     * Part of connection linking it to the signal (sender) and to the slot
+     * holder's intrusive list of connections.
+     */
+    class connection_link
+        : public sigslot_details::stats_holder<slot_stats, ProfilingPolicy::enabled>
+    {
+        friend class slot_holder_base;
+        friend class connection_handle;
+
+    protected:
+        basic_signal *      _sender {nullptr};
+        connection_link *   _prev {nullptr}; // Slot holder's list
+        connection_link *   _next {nullptr}; // Slot holder's list
+        connection_handle * _tracker {nullptr};
+
+    public:
+        connection_link (basic_signal * sender) : _sender(sender) {}
+
+        // Must be destroyed under sender's lock
+        virtual ~connection_link ()
+        {
+            if (_tracker) {
+                _tracker->_link.store(nullptr, std::memory_order_relaxed);
+                _tracker->_sender.store(nullptr, std::memory_order_release);
+            }
+        }
+
+        basic_signal * sender () const noexcept
+        {
+            return _sender;
+        }
+
+        // Delivers accumulated events if they are waiting too long
+        // (see batch_connection)
+        virtual void flush_pending (std::chrono::steady_clock::time_point) {}
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// connection_handle
+////////////////////////////////////////////////////////////////////////////////
+    /**
+     * Handle of the connection returned by signal's connect().
+     *
+     * Handle is movable but not copyable. It tracks the connection and is
+     * reset automatically when connection is destroyed by any other way
+     * (disconnection of the slot holder, disconnect_all(), signal
+     * destruction). Destroying the handle does not disconnect the connection,
+     * use scoped_connection for that.
+     *
+     * Handle may be used from any thread while the connection is destroyed
+     * by other one (it is reset under the signal's lock), but must not be
+     * used concurrently with the destruction of the signal it is connected
+     * to. Handle itself is not shared between threads.
+     */
+    class connection_handle
+    {
+        friend class connection_link;
+
+    protected:
+        // Both are reset under the sender's lock when connection destroyed
+        std::atomic<connection_link *> _link {nullptr};
+        std::atomic<basic_signal *> _sender {nullptr};
+
+    public:
+        connection_handle () {}
+
+        // Must be called with the sender's mutex locked
+        explicit connection_handle (connection_link * link)
+        {
+            if (link) {
+                _link.store(link, std::memory_order_relaxed);
+                _sender.store(link->_sender, std::memory_order_relaxed);
+                link->_tracker = this;
+            }
+        }
+
+        connection_handle (connection_handle && other)
+        {
+            move_from(other);
+        }
+
+        connection_handle & operator = (connection_handle && other)
+        {
+            if (this != & other) {
+                release();
+                move_from(other);
+            }
+
+            return *this;
+        }
+
+        connection_handle (connection_handle const &) = delete;
+        connection_handle & operator = (connection_handle const &) = delete;
+
+        ~connection_handle ()
+        {
+            release();
+        }
+
+        bool connected () const
+        {
+            return _link.load(std::memory_order_relaxed) != nullptr;
+        }
+
+        /**
+         * Returns delivery statistics of the connection (@c nullptr if
+         * profiling is disabled or connection is destroyed). Statistics
+         * remain valid after the connection destroyed.
+         */
+        std::shared_ptr<slot_stats> stats () const
+        {
+            basic_signal * sender = _sender.load(std::memory_order_acquire);
+
+            if (!sender)
+                return nullptr;
+
+            std::lock_guard<mutex_type> lock(*sender);
+            connection_link * link = _link.load(std::memory_order_relaxed);
+            return link ? link->stats() : nullptr;
+        }
+
+        explicit operator bool () const
+        {
+            return connected();
+        }
+
+        /**
+         * Disconnects connection in O(1) (in O(n) for rcu_signal).
+         *
+         * Connection is read under the signal's lock, so it can not be
+         * destroyed concurrently by the slot holder destruction.
+         *
+         * @return @c false if connection is already destroyed or signal
+         *         is frozen.
+         */
+        bool disconnect ()
+        {
+            basic_signal * sender = _sender.load(std::memory_order_acquire);
+
+            if (!sender)
+                return false;
+
+            std::lock_guard<mutex_type> lock(*sender);
+            connection_link * link = _link.load(std::memory_order_relaxed);
+
+            return link ? sender->disconnect_locked(link) : false;
+        }
+
+        /**
+         * Detaches handle from connection, connection remains alive.
+         */
+        void release ()
+        {
+            basic_signal * sender = _sender.load(std::memory_order_acquire);
+
+            if (!sender)
+                return;
+
+            std::lock_guard<mutex_type> lock(*sender);
+            connection_link * link = _link.load(std::memory_order_relaxed);
+
+            if (link)
+                link->_tracker = nullptr;
+
+            _link.store(nullptr, std::memory_order_relaxed);
+            _sender.store(nullptr, std::memory_order_relaxed);
+        }
+
+    private:
+        void move_from (connection_handle & other)
+        {
+            basic_signal * sender = other._sender.load(std::memory_order_acquire);
+
+            if (!sender)
+                return;
+
+            std::lock_guard<mutex_type> lock(*sender);
+            connection_link * link = other._link.load(std::memory_order_relaxed);
+
+            if (link) {
+                link->_tracker = this;
+                _link.store(link, std::memory_order_relaxed);
+                _sender.store(sender, std::memory_order_relaxed);
+            }
+
+            other._link.store(nullptr, std::memory_order_relaxed);
+            other._sender.store(nullptr, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * Connection handle disconnecting the connection on destruction.
+     */
+    class scoped_connection : public connection_handle
+    {
+    public:
+        scoped_connection () {}
+
+        scoped_connection (connection_handle && h)
+            : connection_handle(std::move(h))
+        {}
+
+        scoped_connection (scoped_connection && other)
+            : connection_handle(std::move(other))
+        {}
+
+        scoped_connection & operator = (connection_handle && h)
+        {
+            this->disconnect();
+            connection_handle::operator = (std::move(h));
+            return *this;
+        }
+
+        scoped_connection & operator = (scoped_connection && other)
+        {
+            this->disconnect();
+            connection_handle::operator = (std::move(other));
+            return *this;
+        }
+
+        ~scoped_connection ()
+        {
+            this->disconnect();
+        }
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// connection_base
+////////////////////////////////////////////////////////////////////////////////
+    template <typename ...Args>
+    class basic_connection;
+
+    /**
+     * Type-erased connection used by frozen signals: emission through
+     * a delegate is a plain function call, the delivery mode (direct,
+     * queued or queued to master) is resolved once when delegate created.
+     */
+    template <typename ...Args>
+    struct slot_delegate
+    {
+        using invoker_type = void (*)(basic_connection<Args...> *, Args const &...);
+        using move_invoker_type = void (*)(basic_connection<Args...> *, Args &&...);
+
+        basic_connection<Args...> * conn;
+        invoker_type invoke;
+        move_invoker_type invoke_move;
+    };
+
+    template <typename ...Args>
+    class basic_connection : public connection_link
+    {
+    public:
+        using payload_type = sigslot_details::payload<Args...>;
+        using shared_payload_type = std::shared_ptr<payload_type const>;
+        using batch_type = std::vector<payload_type>;
+        using shared_batch_type = std::shared_ptr<batch_type const>;
+
+        // Position in the signal's list of connections (for O(1) removal)
+        typename std::list<basic_connection *>::iterator pos;
+
+    public:
+        basic_connection (basic_signal * sender) : connection_link(sender) {}
+        virtual ~basic_connection () {}
+        virtual slot_holder_base * get_slot_holder () const = 0;
+
+        // Arguments are copied (signal has several receivers)
+        virtual void emit_signal (Args const &...) = 0;
+
+        // Arguments are moved into the slot or into the queue item
+        // (last receiver of the signal)
+        virtual void emit_signal_move (Args &&...) = 0;
+
+        // Receiver gets reference to immutable arguments shared by all
+        // receivers (zero-copy if slot accepts arguments by const reference)
+        virtual void emit_signal_shared (shared_payload_type const &) = 0;
+
+        // Receiver gets range of arguments (queued receiver gets it as
+        // single queue item)
+        virtual void emit_batch (shared_batch_type const &) = 0;
+
+        virtual slot_delegate<Args...> make_delegate () = 0;
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// slot_holder_base
+////////////////////////////////////////////////////////////////////////////////
+    /**
+     * Minimal part of slot holder required by connections: intrusive list
+     * of connections and delivery mode. Concrete holder must call
+     * disconnect_all() from its destructor (links mutex is obtained by
+     * virtual call).
+     */
+    class slot_holder_base
+    {
+    protected:
+        // Intrusive list of connections of this holder
+        connection_link * _links {nullptr};
+
+    public:
+        slot_holder_base () {}
+        slot_holder_base (slot_holder_base const &) = delete;
+        slot_holder_base & operator = (slot_holder_base const &) = delete;
+
+        virtual ~slot_holder_base ()
+        {
+            assert(_links == nullptr && "concrete slot holder must call disconnect_all()");
+        }
+
+        virtual bool use_queued_slots () const = 0;
+
+        virtual bool is_slave () const
+        {
+            return false;
+        }
+
+        virtual basic_slot_holder * master () const
+        {
+            assert(this->is_slave());
+            assert(false); // Must be reimplemented in slave_slot_holder
+            return nullptr;
+        }
+
+        void link_connection (connection_link * link)
+        {
+            std::lock_guard<mutex_type> lock(links_mutex());
+            link->_prev = nullptr;
+            link->_next = _links;
+
+            if (_links)
+                _links->_prev = link;
+
+            _links = link;
+        }
+
+        void unlink_connection (connection_link * link)
+        {
+            std::lock_guard<mutex_type> lock(links_mutex());
+            unlink(link);
+        }
+
+        /**
+         * Disconnects all connections of this holder, O(k) for k connections.
+         *
+         * Locks are taken in the same order as by the signal (signal, then
+         * holder), so holder must not be destroyed concurrently with the
+         * destruction of the signals it is connected to.
+         */
+        void disconnect_all ()
+        {
+            std::unique_lock<mutex_type> lock(links_mutex());
+
+            while (_links) {
+                connection_link * link = _links;
+                basic_signal * sender = link->_sender;
+
+                lock.unlock();
+                std::lock_guard<mutex_type> sender_lock(*sender);
+                lock.lock();
+
+                // Connection could be destroyed by the signal meanwhile
+                if (_links == link && link->_sender == sender) {
+                    unlink(link);
+                    sender->slot_disconnect(link);
+                }
+            }
+        }
+
+        /**
+         * Delivers events accumulated by batch slots of this holder if
+         * their linger time expired. Must be called periodically by the
+         * owner of the callback queue (modulus does it from module's loop).
+         */
+        void flush_batches ()
+        {
+            if (batch_connections_count().load(std::memory_order_relaxed) == 0)
+                return;
+
+            auto now = std::chrono::steady_clock::now();
+            std::lock_guard<mutex_type> lock(links_mutex());
+
+            for (connection_link * link = _links; link; link = link->_next)
+                link->flush_pending(now);
+        }
+
+        /**
+         * @return Number of connections (O(k)).
+         */
+        size_t count () const
+        {
+            size_t n = 0;
+
+            for (connection_link * link = _links; link; link = link->_next)
+                ++n;
+
+            return n;
+        }
+
+    protected:
+        // Guards list of connections
+        virtual mutex_type & links_mutex () = 0;
+
+    private:
+        void unlink (connection_link * link)
+        {
+            if (link->_prev)
+                link->_prev->_next = link->_next;
+            else
+                _links = link->_next;
+
+            if (link->_next)
+                link->_next->_prev = link->_prev;
+
+            link->_prev = link->_next = nullptr;
+        }
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// basic_slot_holder
+////////////////////////////////////////////////////////////////////////////////
+    class basic_slot_holder : public slot_holder_base, public mutex_type
+    {
+    protected:
+        std::unique_ptr<callback_queue_type> _queue_ptr;
+
+        // Thread that processes callback queue (used by inline delivery)
+        std::atomic<std::thread::id> _consumer_thread;
+        bool _inline_delivery {false};
+        int  _max_inline_depth {default_max_inline_depth};
+
+    public:
+        static constexpr int default_max_inline_depth = 8;
+
+        // Guards nesting of inline deliveries within current thread
+        class inline_delivery_guard
+        {
+        public:
+            inline_delivery_guard () { ++depth(); }
+            ~inline_delivery_guard () { --depth(); }
+
+            static int & depth ()
+            {
+                static thread_local int __depth = 0;
+                return __depth;
+            }
+        };
+
+    public:
+        basic_slot_holder ()
+            : _consumer_thread(std::thread::id{})
+        {}
+
+        virtual ~basic_slot_holder ()
+        {
+            this->disconnect_all();
+        }
+
+        callback_queue_type & callback_queue ()
+        {
+            return *_queue_ptr;
+        }
+
+        callback_queue_type const & callback_queue () const
+        {
+            return *_queue_ptr;
+        }
+
+        /**
+         * Sets thread that processes the callback queue of this holder
+         * (current thread by default).
+         */
+        void set_consumer_thread (std::thread::id id = std::this_thread::get_id())
+        {
+            _consumer_thread.store(id, std::memory_order_relaxed);
+        }
+
+        std::thread::id consumer_thread () const
+        {
+            return _consumer_thread.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Enables/disables inline delivery for queued slots of this holder
+         * (and slots of its slaves).
+         *
+         * If enabled, a signal emitted from the consumer thread (see
+         * set_consumer_thread()) is delivered by direct call instead of
+         * pushing it into the callback queue. Nested inline deliveries are
+         * limited by @a max_depth, deeper emissions are queued as usual.
+         *
+         * Note that inline delivered event can overtake events already
+         * waiting in the queue.
+         *
+         * Must be set before signals are emitted.
+         */
+        void set_inline_delivery (bool enable, int max_depth = default_max_inline_depth)
+        {
+            _inline_delivery = enable;
+            _max_inline_depth = max_depth;
+        }
+
+        bool inline_delivery () const noexcept
+        {
+            return _inline_delivery;
+        }
+
+        /**
+         * Checks if event for queued slot can be delivered by direct call.
+         */
+        bool accept_inline_delivery () const
+        {
+            return _inline_delivery
+                && inline_delivery_guard::depth() < _max_inline_depth
+                && _consumer_thread.load(std::memory_order_relaxed) == std::this_thread::get_id();
+        }
+
+    protected:
+        virtual mutex_type & links_mutex () override
+        {
+            return *this;
+        }
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// slot_holder
+////////////////////////////////////////////////////////////////////////////////
+    class slot_holder : public basic_slot_holder
+    {
+    public:
+        slot_holder () : basic_slot_holder ()
+        {}
+
+        virtual bool use_queued_slots () const override
+        {
+            return false;
+        }
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// queued_slot_holder
+////////////////////////////////////////////////////////////////////////////////
+    class queued_slot_holder : public basic_slot_holder
+    {
+    public:
+        queued_slot_holder () : basic_slot_holder ()
+        {
+            this->_queue_ptr = make_unique<callback_queue_type>();
+        }
+
+        virtual bool use_queued_slots () const override
+        {
+            return true;
+        }
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// slave_slot_holder
+////////////////////////////////////////////////////////////////////////////////
+    class slave_slot_holder : public basic_slot_holder
+    {
+        basic_slot_holder * _master;
+
+    public:
+        slave_slot_holder (basic_slot_holder * master) : _master(master) {}
+        virtual bool use_queued_slots () const override { return false; }
+        virtual bool is_slave () const override { return true; }
+        virtual basic_slot_holder * master () const { return _master; }
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// compact_slot_holder
+////////////////////////////////////////////////////////////////////////////////
+    /**
+     * Slot holder for objects created in large numbers (per-connection,
+     * per-entity objects). It has no mutex and no callback queue of its own
+     * (three pointers in size against about a hundred bytes of
+     * basic_slot_holder):
+     *   - connections list is guarded by one of the mutexes shared by all
+     *     compact holders (striped by holder's address), it is never held
+     *     while locking a signal (see slot_holder_base::disconnect_all());
+     *   - if @a owner specified, slots are called from the owner's callback
+     *     queue (like slots of slave_slot_holder), otherwise slots are
+     *     called directly.
+     *
+     * Owner must outlive the holder.
+     */
+    class compact_slot_holder : public slot_holder_base
+    {
+        basic_slot_holder * _owner {nullptr};
+
+    public:
+        static constexpr std::size_t stripe_count = 64;
+
+    public:
+        compact_slot_holder (basic_slot_holder * owner = nullptr)
+            : _owner(owner)
+        {}
+
+        ~compact_slot_holder ()
+        {
+            this->disconnect_all();
+        }
+
+        basic_slot_holder * owner () const noexcept
+        {
+            return _owner;
+        }
+
+        virtual bool use_queued_slots () const override
+        {
+            return false;
+        }
+
+        virtual bool is_slave () const override
+        {
+            return _owner != nullptr;
+        }
+
+        virtual basic_slot_holder * master () const override
+        {
+            return _owner;
+        }
+
+    protected:
+        virtual mutex_type & links_mutex () override
+        {
+            static mutex_type __stripes[stripe_count];
+            auto index = (reinterpret_cast<std::uintptr_t>(this) / sizeof(void *)) % stripe_count;
+            return __stripes[index];
+        }
+    };
+
+
+    static basic_slot_holder * own_queue_owner (basic_slot_holder * p)
+    {
+        return p;
+    }
+
+    // Holders without own callback queue (compact_slot_holder)
+    static basic_slot_holder * own_queue_owner (slot_holder_base *)
+    {
+        assert(false && "slot holder has no callback queue");
+        return nullptr;
+    }
+
+    // Number of live batch connections (flush_batches() does nothing
+    // if there are no batch connections at all)
+    static std::atomic<int> & batch_connections_count ()
+    {
+        static std::atomic<int> __count {0};
+        return __count;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// signal_base
+////////////////////////////////////////////////////////////////////////////////
+    template <typename ...Args>
+    class signal_base : public basic_signal
+    {
+    public:
+        using connections_list = std::list<basic_connection<Args...> *>  ;
+
+        signal_base ()
+        {}
+
+        ~signal_base ()
+        {
+            disconnect_all();
+        }
+
+        void disconnect_all ()
+        {
+            std::lock_guard<mutex_type> lock(*this);
+
+            for (auto conn: _connected_slots) {
+                conn->get_slot_holder()->unlink_connection(conn);
+                delete conn;
+            }
+
+            _connected_slots.clear();
+        }
+
+        /**
+         * Disconnects first connection to the slot holder @a pclass (O(n)).
+         */
+        void disconnect (slot_holder_base * pclass)
+        {
+            std::lock_guard<mutex_type> lock(*this);
+            auto it = _connected_slots.begin();
+            auto last = _connected_slots.end();
+
+            while (it != last) {
+                if ((*it)->get_slot_holder() == pclass) {
+                    basic_connection<Args...> * conn = *it;
+                    _connected_slots.erase(it);
+                    pclass->unlink_connection(conn);
+                    delete conn;
+                    return;
+                }
+
+                ++it;
+            }
+        }
+
+        using basic_signal::disconnect;
+
+        virtual void slot_disconnect (connection_link * link) override
+        {
+            auto conn = static_cast<basic_connection<Args...> *>(link);
+            _connected_slots.erase(conn->pos);
+            delete conn;
+        }
+
+        bool is_connected () const
+        {
+            return _connected_slots.size() > 0;
+        }
+
+    protected:
+        virtual bool disconnect_locked (connection_link * link) override
+        {
+            auto conn = static_cast<basic_connection<Args...> *>(link);
+            conn->get_slot_holder()->unlink_connection(conn);
+            _connected_slots.erase(conn->pos);
+            delete conn;
+            return true;
+        }
+
+        // Must be called with the signal's mutex locked
+        void append (slot_holder_base * pclass, basic_connection<Args...> * conn)
+        {
+            conn->pos = _connected_slots.insert(_connected_slots.end(), conn);
+            pclass->link_connection(conn);
+        }
+
+    protected:
+        connections_list _connected_slots;
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// basic_connection_impl
+////////////////////////////////////////////////////////////////////////////////
+    /**
+     * Implements delivery of signal arguments to the slot (direct call or
+     * push into holder's or master's callback queue). @a Derived provides
+     * `callable()` returning the slot.
+     *
+     * Arguments of type that is not copy constructible (e.g.
+     * std::unique_ptr) can be delivered to the last receiver only
+     * (see emit_signal_move()).
+     */
+    template <typename Derived, typename SlotHolderClass, typename ...Args>
+    class basic_connection_impl : public basic_connection<Args...>
+    {
+        using base_class = basic_connection<Args...>;
+        using payload_type = typename base_class::payload_type;
+        using shared_payload_type = typename base_class::shared_payload_type;
+        using shared_batch_type = typename base_class::shared_batch_type;
+        using copyable = sigslot_details::all_copy_constructible<Args...>;
+
+    protected:
+        SlotHolderClass * _pobject {nullptr};
+
+    protected:
+        // Derived connection with filter hides is_filtered and accept()
+        static constexpr bool is_filtered = false;
+
+        basic_connection_impl (basic_signal * sender, SlotHolderClass * pobject)
+            : base_class(sender)
+            , _pobject(pobject)
+        {}
+
+        bool accept (Args const &...)
+        {
+            return true;
+        }
+
+    public:
+        virtual slot_holder_base * get_slot_holder () const override
+        {
+            return _pobject;
+        }
+
+        virtual void emit_signal (Args const &... args) override
+        {
+            if (_pobject->use_queued_slots())
+                invoke_queued<false>(this, args...);
+            else if (_pobject->is_slave())
+                invoke_queued<true>(this, args...);
+            else
+                invoke_direct(this, args...);
+        }
+
+        virtual void emit_signal_move (Args &&... args) override
+        {
+            if (_pobject->use_queued_slots())
+                invoke_queued_move<false>(this, std::forward<Args>(args)...);
+            else if (_pobject->is_slave())
+                invoke_queued_move<true>(this, std::forward<Args>(args)...);
+            else
+                invoke_direct_move(this, std::forward<Args>(args)...);
+        }
+
+        virtual void emit_signal_shared (shared_payload_type const & payload) override
+        {
+            emit_signal_shared(copyable(), payload);
+        }
+
+        virtual void emit_batch (shared_batch_type const & batch) override
+        {
+            emit_batch(copyable(), batch);
+        }
+
+        virtual slot_delegate<Args...> make_delegate () override
+        {
+            slot_delegate<Args...> d;
+            d.conn = this;
+
+            if (_pobject->use_queued_slots()) {
+                d.invoke = & basic_connection_impl::template invoke_queued<false>;
+                d.invoke_move = & basic_connection_impl::template invoke_queued_move<false>;
+            } else if (_pobject->is_slave()) {
+                d.invoke = & basic_connection_impl::template invoke_queued<true>;
+                d.invoke_move = & basic_connection_impl::template invoke_queued_move<true>;
+            } else {
+                d.invoke = & basic_connection_impl::invoke_direct;
+                d.invoke_move = & basic_connection_impl::invoke_direct_move;
+            }
+
+            return d;
+        }
+
+    private:
+        static Derived * self (base_class * base)
+        {
+            return static_cast<Derived *>(base);
+        }
+
+        template <bool Master>
+        static basic_slot_holder * queue_owner (Derived * d)
+        {
+            return Master ? d->_pobject->master() : own_queue_owner(d->_pobject);
+        }
+
+        template <bool Master>
+        static callback_queue_type & queue (Derived * d)
+        {
+            return queue_owner<Master>(d)->callback_queue();
+        }
+
+        template <std::size_t ...I>
+        bool accept_payload (payload_type const & args, sigslot_details::index_sequence<I...>)
+        {
+            return self(this)->accept(std::get<I>(args)...);
+        }
+
+        void emit_signal_shared (std::true_type, shared_payload_type const & payload)
+        {
+            if (!accept_payload(*payload, sigslot_details::make_index_sequence<sizeof...(Args)>()))
+                return;
+
+            using invoker_type = sigslot_details::shared_payload_invoker<typename Derived::callable_type, Args...>;
+            invoker_type invoker {self(this)->callable(), payload};
+
+            if (_pobject->use_queued_slots())
+                push_or_call<false>(self(this), std::move(invoker));
+            else if (_pobject->is_slave())
+                push_or_call<true>(self(this), std::move(invoker));
+            else
+                call(self(this), invoker);
+        }
+
+        void emit_signal_shared (std::false_type, shared_payload_type const &)
+        {
+            assert(false && "arguments are not copy constructible, use emit_signal() instead");
+        }
+
+        void emit_batch (std::true_type, shared_batch_type const & batch)
+        {
+            using invoker_type = sigslot_details::batch_invoker<typename Derived::callable_type, Args...>;
+            invoker_type invoker {self(this)->callable(), batch};
+
+            if (Derived::is_filtered) {
+                typename base_class::batch_type accepted;
+
+                for (auto const & args: *batch) {
+                    if (accept_payload(args, sigslot_details::make_index_sequence<sizeof...(Args)>()))
+                        accepted.push_back(args);
+                }
+
+                if (accepted.empty())
+                    return;
+
+                if (accepted.size() != batch->size())
+                    invoker.batch = std::make_shared<typename base_class::batch_type const>(std::move(accepted));
+            }
+
+            if (_pobject->use_queued_slots())
+                push_or_call<false>(self(this), std::move(invoker));
+            else if (_pobject->is_slave())
+                push_or_call<true>(self(this), std::move(invoker));
+            else
+                call(self(this), invoker);
+        }
+
+        void emit_batch (std::false_type, shared_batch_type const &)
+        {
+            assert(false && "arguments are not copy constructible, use emit_signal() instead");
+        }
+
+        static void invoke_direct (base_class * base, Args const &... args)
+        {
+            if (self(base)->accept(args...))
+                invoke_direct(copyable(), self(base), args...);
+        }
+
+        static void invoke_direct (std::true_type, Derived * d, Args const &... args)
+        {
+            delivery_scope scope(d->stats_ptr());
+            d->callable()(args...);
+        }
+
+        static void invoke_direct (std::false_type, Derived *, Args const &...)
+        {
+            assert(false && "arguments are not copy constructible, signal must have single receiver");
+        }
+
+        template <bool Master>
+        static void invoke_queued (base_class * base, Args const &... args)
+        {
+            if (self(base)->accept(args...))
+                invoke_queued<Master>(copyable(), self(base), args...);
+        }
+
+        template <typename Invoker>
+        static void call (Derived * d, Invoker & invoker)
+        {
+            delivery_scope scope(d->stats_ptr());
+            invoker();
+        }
+
+        template <bool Master, typename Invoker>
+        static void push_or_call (Derived * d, Invoker && invoker)
+        {
+            if (queue_owner<Master>(d)->accept_inline_delivery()) {
+                typename basic_slot_holder::inline_delivery_guard guard;
+                call(d, invoker);
+            } else {
+                queue<Master>(d).push(sigslot_details::profile_invoker(
+                    std::forward<Invoker>(invoker), *d));
+            }
+        }
+
+        template <bool Master>
+        static void invoke_queued (std::true_type, Derived * d, Args const &... args)
+        {
+            using invoker_type = sigslot_details::payload_invoker<typename Derived::callable_type, Args...>;
+
+            if (queue_owner<Master>(d)->accept_inline_delivery()) {
+                typename basic_slot_holder::inline_delivery_guard guard;
+                delivery_scope scope(d->stats_ptr());
+                d->callable()(args...);
+            } else {
+                queue<Master>(d).push(sigslot_details::profile_invoker(
+                    invoker_type{d->callable(), payload_type(args...)}, *d));
+            }
+        }
+
+        template <bool Master>
+        static void invoke_queued (std::false_type, Derived *, Args const &...)
+        {
+            assert(false && "arguments are not copy constructible, signal must have single receiver");
+        }
+
+        static void invoke_direct_move (base_class * base, Args &&... args)
+        {
+            Derived * d = self(base);
+
+            if (d->accept(args...)) {
+                delivery_scope scope(d->stats_ptr());
+                d->callable()(std::forward<Args>(args)...);
+            }
+        }
+
+        template <bool Master>
+        static void invoke_queued_move (base_class * base, Args &&... args)
+        {
+            Derived * d = self(base);
+
+            if (!d->accept(args...))
+                return;
+
+            if (queue_owner<Master>(d)->accept_inline_delivery()) {
+                typename basic_slot_holder::inline_delivery_guard guard;
+                delivery_scope scope(d->stats_ptr());
+                d->callable()(std::forward<Args>(args)...);
+            } else {
+                invoke_queued_move<Master>(copyable(), d, std::forward<Args>(args)...);
+            }
+        }
+
+        template <bool Master>
+        static void invoke_queued_move (std::true_type, Derived * d, Args &&... args)
+        {
+            using invoker_type = sigslot_details::payload_invoker<typename Derived::callable_type, Args...>;
+            queue<Master>(d).push(sigslot_details::profile_invoker(invoker_type{d->callable()
+                , payload_type(std::forward<Args>(args)...)}, *d));
+        }
+
+        template <bool Master>
+        static void invoke_queued_move (std::false_type, Derived * d, Args &&... args)
+        {
+            using invoker_type = sigslot_details::moved_payload_invoker<typename Derived::callable_type, Args...>;
+            queue<Master>(d).push(sigslot_details::profile_invoker(invoker_type{d->callable()
+                , std::make_shared<payload_type>(std::forward<Args>(args)...)}, *d));
+        }
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// connection
+////////////////////////////////////////////////////////////////////////////////
+    template <typename SlotHolderClass, typename ...Args>
+    class connection : public basic_connection_impl<connection<SlotHolderClass, Args...>
+        , SlotHolderClass, Args...>
+    {
+        using base_class = basic_connection_impl<connection, SlotHolderClass, Args...>;
+        friend base_class;
+
+    public:
+        using callable_type = sigslot_details::member_slot<SlotHolderClass, Args...>;
+
+    public:
+        connection (basic_signal * sender
+                , SlotHolderClass * pobject
+                , void (SlotHolderClass::*pmemfun)(Args...))
+            : base_class(sender, pobject)
+            , _pmemfun(pmemfun)
+        {}
+
+    private:
+        callable_type callable () const
+        {
+            return callable_type{this->_pobject, _pmemfun};
+        }
+
+    private:
+        void (SlotHolderClass::* _pmemfun)(Args...);
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// functor_connection
+////////////////////////////////////////////////////////////////////////////////
+    /**
+     * Connection to arbitrary callable (lambda, functor, std::function).
+     * Callable is stored by value inside the connection object, so it costs
+     * no extra heap allocation. Slot holder owns the connection (it is
+     * disconnected when holder destroyed) and selects the queue the callable
+     * is executed from.
+     */
+    template <typename SlotHolderClass, typename F, typename ...Args>
+    class functor_connection : public basic_connection_impl<functor_connection<SlotHolderClass, F, Args...>
+        , SlotHolderClass, Args...>
+    {
+        using base_class = basic_connection_impl<functor_connection, SlotHolderClass, Args...>;
+        friend base_class;
+
+    public:
+        using callable_type = F;
+
+    public:
+        functor_connection (basic_signal * sender, SlotHolderClass * pobject, F && f)
+            : base_class(sender, pobject)
+            , _f(std::move(f))
+        {}
+
+        functor_connection (basic_signal * sender, SlotHolderClass * pobject, F const & f)
+            : base_class(sender, pobject)
+            , _f(f)
+        {}
+
+    private:
+        F & callable ()
+        {
+            return _f;
+        }
+
+    private:
+        F _f;
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// filtered_connection
+////////////////////////////////////////////////////////////////////////////////
+    /**
+     * Connection with predicate `bool (Args const &...)` called on the
+     * emitter's thread before the event is copied into the queue (or before
+     * direct call). Rejected events do not reach receiver's queue and
+     * do not wake up its thread.
+     */
+    template <typename SlotHolderClass, typename Callable, typename Filter, typename ...Args>
+    class filtered_connection : public basic_connection_impl<
+        filtered_connection<SlotHolderClass, Callable, Filter, Args...>, SlotHolderClass, Args...>
+    {
+        using base_class = basic_connection_impl<filtered_connection, SlotHolderClass, Args...>;
+        friend base_class;
+
+    public:
+        using callable_type = Callable;
+
+    public:
+        filtered_connection (basic_signal * sender
+                , SlotHolderClass * pobject
+                , Callable callable
+                , Filter filter)
+            : base_class(sender, pobject)
+            , _callable(std::move(callable))
+            , _filter(std::move(filter))
+        {}
+
+    private:
+        static constexpr bool is_filtered = true;
+
+        Callable & callable ()
+        {
+            return _callable;
+        }
+
+        bool accept (Args const &... args)
+        {
+            return _filter(args...);
+        }
+
+    private:
+        Callable _callable;
+        Filter _filter;
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// batch_connection
+////////////////////////////////////////////////////////////////////////////////
+    /**
+     * Connection to batch slot: `void (SlotHolderClass::*)(batch_span<Args...>)`.
+     *
+     * Emitted arguments are accumulated by the connection. For queued slots
+     * single drain item is pushed into the callback queue, it calls the slot
+     * with all events accumulated at drain time, split into chunks of
+     * @c max_batch size at most. Drain item is pushed when:
+     *   - @c linger is zero (on first pending event);
+     *   - number of pending events reached @c max_batch;
+     *   - oldest pending event waits longer than @c linger (checked by
+     *     slot_holder_base::flush_batches()).
+     *
+     * Direct slots are called immediately with single event batch.
+     * Arguments must be copy constructible.
+     */
+    template <typename SlotHolderClass, typename ...Args>
+    class batch_connection : public basic_connection<Args...>
+    {
+        using base_class = basic_connection<Args...>;
+        using payload_type = typename base_class::payload_type;
+        using shared_payload_type = typename base_class::shared_payload_type;
+        using shared_batch_type = typename base_class::shared_batch_type;
+        using slot_type = void (SlotHolderClass::*)(batch_span<Args...>);
+        using clock_type = std::chrono::steady_clock;
+
+        static_assert(sigslot_details::all_copy_constructible<Args...>::value
+            , "batch slot arguments must be copy constructible");
+
+        struct batch_state
+        {
+            mutex_type mtx;
+            std::vector<payload_type> pending;
+            clock_type::time_point first_time;
+            bool scheduled {false};
+        };
+
+        // Queue item
+        struct drainer
+        {
+            SlotHolderClass * pobject;
+            slot_type pmemfun;
+            std::shared_ptr<batch_state> state;
+            std::size_t max_batch;
+
+            void operator () ()
+            {
+                std::vector<payload_type> items;
+
+                {
+                    std::lock_guard<mutex_type> lock(state->mtx);
+                    items.swap(state->pending);
+                    state->scheduled = false;
+                }
+
+                std::size_t total = items.size();
+
+                for (std::size_t i = 0; i < total; i += max_batch) {
+                    std::size_t n = total - i < max_batch ? total - i : max_batch;
+                    (pobject->*pmemfun)(batch_span<Args...>(items.data() + i, n));
+                }
+            }
+        };
+
+    public:
+        batch_connection (basic_signal * sender
+                , SlotHolderClass * pobject
+                , slot_type pmemfun
+                , std::size_t max_batch
+                , clock_type::duration linger)
+            : base_class(sender)
+            , _pobject(pobject)
+            , _pmemfun(pmemfun)
+            , _max_batch(max_batch > 0 ? max_batch : 1)
+            , _linger(linger)
+            , _state(std::make_shared<batch_state>())
+        {
+            batch_connections_count().fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ~batch_connection ()
+        {
+            batch_connections_count().fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        virtual slot_holder_base * get_slot_holder () const override
+        {
+            return _pobject;
+        }
+
+        virtual void emit_signal (Args const &... args) override
+        {
+            append(payload_type(args...));
+        }
+
+        virtual void emit_signal_move (Args &&... args) override
+        {
+            append(payload_type(std::forward<Args>(args)...));
+        }
+
+        virtual void emit_signal_shared (shared_payload_type const & payload) override
+        {
+            append(payload_type(*payload));
+        }
+
+        virtual void emit_batch (shared_batch_type const & batch) override
+        {
+            if (is_direct()) {
+                delivery_scope scope(this->stats_ptr());
+                (_pobject->*_pmemfun)(batch_span<Args...>(batch->data(), batch->size()));
+                return;
+            }
+
+            bool schedule = false;
+
+            {
+                std::lock_guard<mutex_type> lock(_state->mtx);
+
+                if (_state->pending.empty())
+                    _state->first_time = clock_type::now();
+
+                _state->pending.insert(_state->pending.end(), batch->begin(), batch->end());
+                schedule = need_schedule();
+            }
+
+            if (schedule)
+                push_drainer();
+        }
+
+        virtual slot_delegate<Args...> make_delegate () override
+        {
+            slot_delegate<Args...> d;
+            d.conn = this;
+            d.invoke = & batch_connection::invoke;
+            d.invoke_move = & batch_connection::invoke_move;
+            return d;
+        }
+
+        virtual void flush_pending (clock_type::time_point now) override
+        {
+            bool schedule = false;
+
+            {
+                std::lock_guard<mutex_type> lock(_state->mtx);
+
+                if (!_state->scheduled && !_state->pending.empty()
+                        && now - _state->first_time >= _linger) {
+                    _state->scheduled = true;
+                    schedule = true;
+                }
+            }
+
+            if (schedule)
+                push_drainer();
+        }
+
+    private:
+        static void invoke (base_class * base, Args const &... args)
+        {
+            static_cast<batch_connection *>(base)->emit_signal(args...);
+        }
+
+        static void invoke_move (base_class * base, Args &&... args)
+        {
+            static_cast<batch_connection *>(base)->emit_signal_move(std::forward<Args>(args)...);
+        }
+
+        bool is_direct () const
+        {
+            return !_pobject->use_queued_slots() && !_pobject->is_slave();
+        }
+
+        // Must be called with the state locked
+        bool need_schedule ()
+        {
+            if (_state->scheduled)
+                return false;
+
+            if (_linger == clock_type::duration::zero() || _state->pending.size() >= _max_batch) {
+                _state->scheduled = true;
+                return true;
+            }
+
+            return false;
+        }
+
+        void append (payload_type && args)
+        {
+            if (is_direct()) {
+                delivery_scope scope(this->stats_ptr());
+                (_pobject->*_pmemfun)(batch_span<Args...>(& args, 1));
+                return;
+            }
+
+            bool schedule = false;
+
+            {
+                std::lock_guard<mutex_type> lock(_state->mtx);
+
+                if (_state->pending.empty())
+                    _state->first_time = clock_type::now();
+
+                _state->pending.push_back(std::move(args));
+                schedule = need_schedule();
+            }
+
+            if (schedule)
+                push_drainer();
+        }
+
+        void push_drainer ()
+        {
+            basic_slot_holder * owner = _pobject->use_queued_slots()
+                ? own_queue_owner(_pobject)
+                : _pobject->master();
+
+            owner->callback_queue().push(sigslot_details::profile_invoker(
+                drainer{_pobject, _pmemfun, _state, _max_batch}, *this));
+        }
+
+    private:
+        SlotHolderClass * _pobject {nullptr};
+        slot_type _pmemfun;
+        std::size_t _max_batch;
+        clock_type::duration _linger;
+        std::shared_ptr<batch_state> _state;
+    };
+
+    template <typename F>
+    using enable_if_callable = typename std::enable_if<
+        !std::is_member_function_pointer<typename std::decay<F>::type>::value>::type;
+
+////////////////////////////////////////////////////////////////////////////////
+//
+////////////////////////////////////////////////////////////////////////////////
+    template <typename ...Args>
+    class signal : public signal_base<Args...>
+    {
+        using base_class = signal_base<Args...>;
+        using delegate_type = slot_delegate<Args...>;
+        using batch_type = typename basic_connection<Args...>::batch_type;
+
+        // Flat array of delegates, valid while signal is frozen
+        std::vector<delegate_type> _frozen_slots;
+        std::atomic<bool> _frozen {false};
+
+    public:
+        signal () {}
+
+        /**
+         * Connects method @a pmemfun of slot holder @a pclass.
+         *
+         * @return Connection handle, it is not connected if signal is frozen
+         *         or if arguments are move-only and signal already has receiver.
+         */
+        template <typename SlotHolderClass>
+        connection_handle connect (SlotHolderClass * pclass
+            , void (SlotHolderClass::*pmemfun)(Args...))
+        {
+            return connect_helper(pclass
+                , new connection<SlotHolderClass, Args...>(this, pclass, pmemfun));
+        }
+
+        /**
+         * Connects callable @a f owned by slot holder @a pclass.
+         *
+         * @return Connection handle, it is not connected if signal is frozen
+         *         or if arguments are move-only and signal already has receiver.
+         */
+        template <typename SlotHolderClass, typename F, typename = enable_if_callable<F>>
+        connection_handle connect (SlotHolderClass * pclass, F && f)
+        {
+            using functor_type = typename std::decay<F>::type;
+            using connection_type = functor_connection<SlotHolderClass, functor_type, Args...>;
+
+            return connect_helper(pclass
+                , new connection_type(this, pclass, std::forward<F>(f)));
+        }
+
+        /**
+         * Connects method @a pmemfun of slot holder @a pclass with predicate
+         * @a filter `bool (Args const &...)` (see filtered_connection).
+         */
+        template <typename SlotHolderClass, typename Filter>
+        connection_handle connect (SlotHolderClass * pclass
+            , void (SlotHolderClass::*pmemfun)(Args...)
+            , Filter && filter)
+        {
+            using member_slot = sigslot_details::member_slot<SlotHolderClass, Args...>;
+            using filter_type = typename std::decay<Filter>::type;
+            using connection_type = filtered_connection<SlotHolderClass, member_slot, filter_type, Args...>;
+
+            return connect_helper(pclass, new connection_type(this, pclass
+                , member_slot{pclass, pmemfun}, std::forward<Filter>(filter)));
+        }
+
+        /**
+         * Connects callable @a f owned by slot holder @a pclass with predicate
+         * @a filter `bool (Args const &...)` (see filtered_connection).
+         */
+        template <typename SlotHolderClass, typename F, typename Filter, typename = enable_if_callable<F>>
+        connection_handle connect (SlotHolderClass * pclass, F && f, Filter && filter)
+        {
+            using functor_type = typename std::decay<F>::type;
+            using filter_type = typename std::decay<Filter>::type;
+            using connection_type = filtered_connection<SlotHolderClass, functor_type, filter_type, Args...>;
+
+            return connect_helper(pclass, new connection_type(this, pclass
+                , std::forward<F>(f), std::forward<Filter>(filter)));
+        }
+
+        /**
+         * Connects batch slot @a pmemfun of slot holder @a pclass
+         * (see batch_connection).
+         *
+         * @param max_batch Maximum number of events passed to the slot at once.
+         * @param linger Maximum time the event waits for the batch to fill up.
+         */
+        template <typename SlotHolderClass>
+        connection_handle connect_batch (SlotHolderClass * pclass
+            , void (SlotHolderClass::*pmemfun)(batch_span<Args...>)
+            , std::size_t max_batch
+            , std::chrono::steady_clock::duration linger = std::chrono::steady_clock::duration::zero())
+        {
+            return connect_helper(pclass, new batch_connection<SlotHolderClass, Args...>(
+                this, pclass, pmemfun, max_batch, linger));
+        }
+
+        /**
+         * @return @c false if signal is frozen.
+         */
+        bool disconnect (slot_holder_base * pclass)
+        {
+            if (is_frozen()) {
+                assert(false && "disconnect from frozen signal");
+                return false;
+            }
+
+            base_class::disconnect(pclass);
+            return true;
+        }
+
+        using base_class::disconnect;
+
+        /**
+         * Disconnects all slots. Signal must be unfrozen before (see
+         * unfreeze()), emission may iterate frozen delegates without lock.
+         */
+        void disconnect_all ()
+        {
+            assert(!is_frozen() && "disconnect_all() on frozen signal, call unfreeze() first");
+
+            // Release build fallback, safe only if no emission is in progress
+            unfreeze();
+            base_class::disconnect_all();
+        }
+
+        /**
+         * Called by slot holder on its destruction. Slot holders connected
+         * to frozen signal must outlive it or signal must be unfrozen
+         * before holder destruction (see unfreeze()).
+         */
+        virtual void slot_disconnect (connection_link * link) override
+        {
+            assert(!is_frozen() && "slot holder destroyed while signal is frozen");
+
+            // Release build fallback, safe only if no emission is in progress
+            drop_frozen();
+            base_class::slot_disconnect(link);
+        }
+
+        /**
+         * Compacts connections into flat array of delegates. Since then
+         * emission does not lock the signal and does not use virtual calls,
+         * connect() and disconnect() are rejected.
+         *
+         * Must be called when no emission is in progress, e.g. after
+         * all connections are established and before modules started.
+         */
+        void freeze ()
+        {
+            std::lock_guard<mutex_type> lock(*this);
+
+            if (is_frozen())
+                return;
+
+            _frozen_slots.clear();
+            _frozen_slots.reserve(this->_connected_slots.size());
+
+            for (auto conn: this->_connected_slots)
+                _frozen_slots.push_back(conn->make_delegate());
+
+            _frozen.store(true, std::memory_order_release);
+        }
+
+        bool is_frozen () const noexcept
+        {
+            return _frozen.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Drops flat array of delegates, connect() and disconnect() are
+         * accepted again.
+         *
+         * Frozen emission does not lock the signal, so must be called when
+         * no emission is in progress and none can start concurrently, e.g.
+         * after all emitting threads are joined.
+         */
+        void unfreeze ()
+        {
+            std::lock_guard<mutex_type> lock(*this);
+            drop_frozen();
+        }
+
+        /**
+         * Emits signal. Arguments are copied for each receiver except the
+         * last one, last receiver gets moved arguments. So signals with
+         * move-only argument types (e.g. std::unique_ptr) can have single
+         * receiver only, connecting the second one is rejected.
+         */
+        void emit_signal (Args &&... args)
+        {
+            emission_scope emission(this->stats_ptr());
+
+            if (is_frozen()) {
+                if (_frozen_slots.empty())
+                    return;
+
+                auto first = _frozen_slots.data();
+                auto last  = first + _frozen_slots.size() - 1;
+
+                for (; first != last; ++first)
+                    first->invoke(first->conn, args...);
+
+                last->invoke_move(last->conn, std::forward<Args>(args)...);
+                return;
+            }
+
+            std::lock_guard<mutex_type> lock(*this);
+            auto it = this->_connected_slots.cbegin();
+            auto last = this->_connected_slots.cend();
+
+            while (it != last) {
+                auto next = it;
+                ++next;
+
+                if (next == last)
+                    (*it)->emit_signal_move(std::forward<Args>(args)...);
+                else
+                    (*it)->emit_signal(args...);
+
+                it = next;
+            }
+        }
+
+        /**
+         * Emits signal with arguments stored in single immutable reference
+         * counted payload shared by all receivers. Fan-out of N queued
+         * receivers costs one allocation instead of N copies of arguments.
+         * Receivers avoid copying entirely if accept arguments by
+         * const reference.
+         */
+        void emit_signal_shared (Args &&... args)
+        {
+            using payload_type = typename basic_connection<Args...>::payload_type;
+
+            emission_scope emission(this->stats_ptr());
+
+            auto payload = std::make_shared<payload_type const>(std::forward<Args>(args)...);
+
+            if (is_frozen()) {
+                for (auto & d: _frozen_slots)
+                    d.conn->emit_signal_shared(payload);
+
+                return;
+            }
+
+            std::lock_guard<mutex_type> lock(*this);
+
+            for (auto conn: this->_connected_slots)
+                conn->emit_signal_shared(payload);
+        }
+
+        /**
+         * Emits signal for each tuple of arguments in range [@a first, @a last)
+         * (value type must be convertible to std::tuple<Args...> with decayed
+         * argument types).
+         *
+         * Connections are walked once for the whole range and queued receiver
+         * gets the range as single queue item. Range is copied once into
+         * immutable buffer shared by all receivers.
+         */
+        template <typename ForwardIt>
+        void emit_batch (ForwardIt first, ForwardIt last)
+        {
+            emit_batch(batch_type(first, last));
+        }
+
+        /**
+         * Same as emit_batch(first, last) but takes ownership of @a batch
+         * without copying.
+         */
+        void emit_batch (std::vector<sigslot_details::payload<Args...>> && batch)
+        {
+            if (batch.empty())
+                return;
+
+            emission_scope emission(this->stats_ptr(), batch.size());
+
+            auto shared_batch = std::make_shared<batch_type const>(std::move(batch));
+
+            if (is_frozen()) {
+                for (auto & d: _frozen_slots)
+                    d.conn->emit_batch(shared_batch);
+
+                return;
+            }
+
+            std::lock_guard<mutex_type> lock(*this);
+
+            for (auto conn: this->_connected_slots)
+                conn->emit_batch(shared_batch);
+        }
+
+        void operator () (Args &&... args)
+        {
+            emit_signal(std::forward<Args>(args)...);
+        }
+
+    protected:
+        // Rejects disconnection if signal is frozen
+        virtual bool disconnect_locked (connection_link * link) override
+        {
+            if (is_frozen()) {
+                assert(false && "disconnect from frozen signal");
+                return false;
+            }
+
+            return base_class::disconnect_locked(link);
+        }
+
+    private:
+        // Must be called with the signal's mutex locked
+        void drop_frozen ()
+        {
+            _frozen.store(false, std::memory_order_release);
+            _frozen_slots.clear();
+        }
+
+        connection_handle connect_helper (slot_holder_base * pclass
+            , basic_connection<Args...> * conn)
+        {
+            std::unique_lock<mutex_type> lock(*this);
+            bool frozen = is_frozen();
+
+            // Move-only arguments can be delivered to single receiver only
+            bool single_receiver = !sigslot_details::all_copy_constructible<Args...>::value
+                && !this->_connected_slots.empty();
+
+            bool rejected = frozen || single_receiver;
+
+            if (!rejected)
+                this->append(pclass, conn);
+
+            // Handle is bound under the lock, single return allows NRVO
+            connection_handle h(rejected ? nullptr : conn);
+            lock.unlock();
+
+            if (rejected) {
+                assert(!frozen && "connect to frozen signal");
+                delete conn;
+            }
+
+            return h;
+        }
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+// rcu_signal
+////////////////////////////////////////////////////////////////////////////////
+    /**
+     * Signal with copy-on-write connection list.
+     *
+     * Connections are stored in an immutable snapshot which is replaced
+     * atomically by connect/disconnect (writers are serialized by the signal's
+     * mutex). Emission does not lock the mutex: an emitter registers itself
+     * in the readers counter of the current epoch, loads the snapshot and
+     * walks it, so concurrent emitters never block each other and a slow
+     * direct slot does not block anybody else.
+     *
+     * The replaced snapshot and disconnected connections are reclaimed by the
+     * writer after a grace period (all emissions started before replacement
+     * are finished). As a consequence connect/disconnect must not be called
+     * from a slot connected to the same signal.
+     */
+    template <typename ...Args>
+    class rcu_signal : public basic_signal
+    {
+        using connection_type = basic_connection<Args...>;
+        using snapshot_type = std::vector<connection_type *>;
+        using batch_type = typename connection_type::batch_type;
+
+        struct reader_guard
+        {
+            std::atomic<std::size_t> & counter;
+
+            reader_guard (std::atomic<std::size_t> & c) : counter(c)
+            {
+                counter.fetch_add(1);
+            }
+
+            ~reader_guard ()
+            {
+                counter.fetch_sub(1);
+            }
+        };
+
+        std::atomic<snapshot_type const *> _snapshot {nullptr};
+        std::atomic<unsigned> _epoch {0};
+        std::atomic<std::size_t> _readers[2];
+
+    public:
+        rcu_signal ()
+        {
+            _readers[0].store(0);
+            _readers[1].store(0);
+        }
+
+        ~rcu_signal ()
+        {
+            disconnect_all();
+        }
+
+        template <typename SlotHolderClass>
+        connection_handle connect (SlotHolderClass * pclass
+            , void (SlotHolderClass::*pmemfun)(Args...))
+        {
+            return append(pclass, new connection<SlotHolderClass, Args...>(this, pclass, pmemfun));
+        }
+
+        template <typename SlotHolderClass, typename F, typename = enable_if_callable<F>>
+        connection_handle connect (SlotHolderClass * pclass, F && f)
+        {
+            using functor_type = typename std::decay<F>::type;
+            return append(pclass, new functor_connection<SlotHolderClass, functor_type, Args...>(
+                this, pclass, std::forward<F>(f)));
+        }
+
+        /**
+         * Connects method @a pmemfun of slot holder @a pclass with predicate
+         * @a filter `bool (Args const &...)` (see filtered_connection).
+         */
+        template <typename SlotHolderClass, typename Filter>
+        connection_handle connect (SlotHolderClass * pclass
+            , void (SlotHolderClass::*pmemfun)(Args...)
+            , Filter && filter)
+        {
+            using member_slot = sigslot_details::member_slot<SlotHolderClass, Args...>;
+            using filter_type = typename std::decay<Filter>::type;
+            using connection_type = filtered_connection<SlotHolderClass, member_slot, filter_type, Args...>;
+
+            return append(pclass, new connection_type(this, pclass
+                , member_slot{pclass, pmemfun}, std::forward<Filter>(filter)));
+        }
+
+        /**
+         * Connects callable @a f owned by slot holder @a pclass with predicate
+         * @a filter `bool (Args const &...)` (see filtered_connection).
+         */
+        template <typename SlotHolderClass, typename F, typename Filter, typename = enable_if_callable<F>>
+        connection_handle connect (SlotHolderClass * pclass, F && f, Filter && filter)
+        {
+            using functor_type = typename std::decay<F>::type;
+            using filter_type = typename std::decay<Filter>::type;
+            using connection_type = filtered_connection<SlotHolderClass, functor_type, filter_type, Args...>;
+
+            return append(pclass, new connection_type(this, pclass
+                , std::forward<F>(f), std::forward<Filter>(filter)));
+        }
+
+        /**
+         * @see signal::connect_batch()
+         */
+        template <typename SlotHolderClass>
+        connection_handle connect_batch (SlotHolderClass * pclass
+            , void (SlotHolderClass::*pmemfun)(batch_span<Args...>)
+            , std::size_t max_batch
+            , std::chrono::steady_clock::duration linger = std::chrono::steady_clock::duration::zero())
+        {
+            return append(pclass, new batch_connection<SlotHolderClass, Args...>(
+                this, pclass, pmemfun, max_batch, linger));
+        }
+
+        void disconnect_all ()
+        {
+            std::lock_guard<mutex_type> lock(*this);
+            snapshot_type const * old_snapshot = _snapshot.load();
+
+            if (!old_snapshot)
+                return;
+
+            snapshot_type removed(*old_snapshot);
+
+            for (auto conn: removed)
+                conn->get_slot_holder()->unlink_connection(conn);
+
+            replace(nullptr);
+
+            for (auto conn: removed)
+                delete conn;
+        }
+
+        /**
+         * Disconnects first connection to the slot holder @a pclass.
+         */
+        void disconnect (slot_holder_base * pclass)
+        {
+            std::lock_guard<mutex_type> lock(*this);
+            snapshot_type const * old_snapshot = _snapshot.load();
+
+            if (!old_snapshot)
+                return;
+
+            for (auto conn: *old_snapshot) {
+                if (conn->get_slot_holder() == pclass) {
+                    pclass->unlink_connection(conn);
+                    remove(conn);
+                    return;
+                }
+            }
+        }
+
+        using basic_signal::disconnect;
+
+        virtual void slot_disconnect (connection_link * link) override
+        {
+            remove(static_cast<connection_type *>(link));
+        }
+
+        bool is_connected () const
+        {
+            snapshot_type const * snapshot = _snapshot.load();
+            return snapshot != nullptr && snapshot->size() > 0;
+        }
 
-    class basic_slot_holder;
+        /**
+         * @see signal::emit_signal()
+         */
+        void emit_signal (Args &&... args)
+        {
+            emission_scope emission(this->stats_ptr());
 
-    // see [std::make_unique](http://en.cppreference.com/w/cpp/memory/unique_ptr/make_unique)
-    // `Possible Implementation` section.
-    template<typename T, typename ...Args>
-    static inline std::unique_ptr<T> make_unique (Args &&... args)
-    {
-        return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
-    }
+            reader_guard guard(_readers[_epoch.load() & 1]);
+            snapshot_type const * snapshot = _snapshot.load();
 
-    template <typename SignalType, typename ...Args>
-    static inline void emit_signal (SignalType & sig, Args &&... args)
-    {
-        sig.emit_signal(std::forward<Args>(args)...);
-    }
+            if (snapshot && !snapshot->empty()) {
+                auto first = snapshot->begin();
+                auto last = snapshot->end() - 1;
 
-////////////////////////////////////////////////////////////////////////////////
-// connection_base
-////////////////////////////////////////////////////////////////////////////////
-    template <typename ...Args>
-    class basic_connection
-    {
-    public:
-        virtual ~basic_connection () {}
-        virtual basic_slot_holder * get_slot_holder () const = 0;
-        virtual void emit_signal (Args const &...) = 0;
-    };
+                for (; first != last; ++first)
+                    (*first)->emit_signal(args...);
 
-    class basic_signal : public mutex_type
-    {
-    public:
-        virtual ~basic_signal () {}
-        virtual void slot_disconnect (basic_slot_holder * pslot) = 0;
-    };
+                (*last)->emit_signal_move(std::forward<Args>(args)...);
+            }
+        }
 
-////////////////////////////////////////////////////////////////////////////////
-// basic_slot_holder
-////////////////////////////////////////////////////////////////////////////////
-    class basic_slot_holder : public mutex_type
-    {
-    protected:
-        using sender_set = std::set<basic_signal *>;
-        using const_iterator = typename sender_set::const_iterator ;
+        /**
+         * @see signal::emit_signal_shared()
+         */
+        void emit_signal_shared (Args &&... args)
+        {
+            using payload_type = typename connection_type::payload_type;
 
-        sender_set _senders;
-        std::unique_ptr<callback_queue_type> _queue_ptr;
+            emission_scope emission(this->stats_ptr());
 
-    public:
-        basic_slot_holder ()
-        {}
+            reader_guard guard(_readers[_epoch.load() & 1]);
+            snapshot_type const * snapshot = _snapshot.load();
 
-        virtual bool use_queued_slots () const = 0;
+            if (snapshot && !snapshot->empty()) {
+                auto payload = std::make_shared<payload_type const>(std::forward<Args>(args)...);
 
-        virtual bool is_slave () const
-        {
-            return false;
+                for (auto conn: *snapshot)
+                    conn->emit_signal_shared(payload);
+            }
         }
 
-        virtual basic_slot_holder * master () const
+        /**
+         * @see signal::emit_batch()
+         */
+        template <typename ForwardIt>
+        void emit_batch (ForwardIt first, ForwardIt last)
         {
-            assert(this->is_slave());
-            assert(false); // Must be reimplemented in slave_slot_holder
-            return nullptr;
+            emit_batch(batch_type(first, last));
         }
 
-        void signal_connect (basic_signal * sender)
+        /**
+         * @see signal::emit_batch()
+         */
+        void emit_batch (std::vector<sigslot_details::payload<Args...>> && batch)
         {
-            std::lock_guard<mutex_type> lock(*this);
-            _senders.insert(sender);
+            if (batch.empty())
+                return;
+
+            emission_scope emission(this->stats_ptr(), batch.size());
+
+            reader_guard guard(_readers[_epoch.load() & 1]);
+            snapshot_type const * snapshot = _snapshot.load();
+
+            if (snapshot && !snapshot->empty()) {
+                auto shared_batch = std::make_shared<batch_type const>(std::move(batch));
+
+                for (auto conn: *snapshot)
+                    conn->emit_batch(shared_batch);
+            }
         }
 
-        void signal_disconnect (basic_signal * sender)
+        void operator () (Args &&... args)
         {
-            std::lock_guard<mutex_type> lock(*this);
-            _senders.erase(sender);
+            emit_signal(std::forward<Args>(args)...);
         }
 
-        virtual ~basic_slot_holder ()
+    protected:
+        // O(n), snapshot is copied
+        virtual bool disconnect_locked (connection_link * link) override
         {
-            disconnect_all();
+            auto conn = static_cast<connection_type *>(link);
+            conn->get_slot_holder()->unlink_connection(conn);
+            remove(conn);
+            return true;
         }
 
-        void disconnect_all ()
+    private:
+        connection_handle append (slot_holder_base * pclass, connection_type * conn)
         {
-            std::lock_guard<mutex_type> lock(*this);
-            const_iterator it = _senders.begin();
-            const_iterator last = _senders.end();
-
-            while (it != last) {
-                (*it)->slot_disconnect(this);
-                ++it;
+            std::unique_lock<mutex_type> lock(*this);
+            snapshot_type const * old_snapshot = _snapshot.load();
+
+            // Move-only arguments can be delivered to single receiver only
+            if (!sigslot_details::all_copy_constructible<Args...>::value
+                    && old_snapshot && !old_snapshot->empty()) {
+                lock.unlock();
+                delete conn;
+                return connection_handle();
             }
 
-            _senders.erase(_senders.begin(), _senders.end());
+            snapshot_type * new_snapshot = old_snapshot
+                ? new snapshot_type(*old_snapshot)
+                : new snapshot_type;
+
+            new_snapshot->push_back(conn);
+            replace(new_snapshot);
+            pclass->link_connection(conn);
+
+            connection_handle h(conn);
+            lock.unlock();
+            return h;
         }
 
-        size_t count () const
+        // Removes connection from snapshot and destroys it after grace
+        // period. Must be called with the signal's mutex locked.
+        void remove (connection_type * conn)
         {
-            return _senders.size();
+            snapshot_type const * old_snapshot = _snapshot.load();
+            auto new_snapshot = new snapshot_type;
+            new_snapshot->reserve(old_snapshot->size() - 1);
+
+            for (auto c: *old_snapshot) {
+                if (c != conn)
+                    new_snapshot->push_back(c);
+            }
+
+            replace(new_snapshot);
+            delete conn;
         }
 
-        callback_queue_type & callback_queue ()
+        // Publishes new snapshot and destroys the previous one after
+        // grace period. Must be called with the signal's mutex locked.
+        void replace (snapshot_type const * new_snapshot)
         {
-            return *_queue_ptr;
+            snapshot_type const * old_snapshot = _snapshot.exchange(new_snapshot);
+            synchronize();
+            delete old_snapshot;
         }
 
-        callback_queue_type const & callback_queue () const
+        // Waits until all emissions started before the call are finished.
+        // Epoch is flipped twice to catch emitters that read the epoch value
+        // before the first flip but registered themselves after it.
+        void synchronize ()
         {
-            return *_queue_ptr;
+            for (int i = 0; i < 2; i++) {
+                unsigned prev_epoch = _epoch.fetch_add(1);
+
+                while (_readers[prev_epoch & 1].load() != 0)
+                    std::this_thread::yield();
+            }
         }
     };
 
 ////////////////////////////////////////////////////////////////////////////////
-// slot_holder
+// Rate limiting signal adapters
 ////////////////////////////////////////////////////////////////////////////////
-    class slot_holder : public basic_slot_holder
+    /**
+     * Base of rate limiting adapters. Adapter is not a signal: it owns
+     * the output signal, receivers are connected to it through adapter's
+     * connect() (or output()), emissions are passed to it by adapter's
+     * emit_signal() only. So an adapter can not be emitted by mistake
+     * through a reference to plain signal bypassing rate limiting.
+     */
+    template <typename ...Args>
+    class signal_adapter_base
     {
     public:
-        slot_holder () : basic_slot_holder ()
-        {}
+        using signal_type = signal<Args...>;
 
-        virtual bool use_queued_slots () const override
+    protected:
+        signal_type _signal;
+        std::atomic<std::size_t> _emitted {0};
+        std::atomic<std::size_t> _suppressed {0};
+
+    public:
+        /**
+         * Connects receiver to the output signal (see signal::connect()).
+         */
+        template <typename ...Ts>
+        connection_handle connect (Ts &&... args)
         {
-            return false;
+            return _signal.connect(std::forward<Ts>(args)...);
         }
-    };
 
-////////////////////////////////////////////////////////////////////////////////
-// queued_slot_holder
-////////////////////////////////////////////////////////////////////////////////
-    class queued_slot_holder : public basic_slot_holder
-    {
-    public:
-        queued_slot_holder () : basic_slot_holder ()
+        /**
+         * @see signal::connect_batch()
+         */
+        template <typename ...Ts>
+        connection_handle connect_batch (Ts &&... args)
         {
-            this->_queue_ptr = make_unique<callback_queue_type>();
+            return _signal.connect_batch(std::forward<Ts>(args)...);
         }
 
-        virtual bool use_queued_slots () const override
+        void disconnect_all ()
         {
-            return true;
+            _signal.disconnect_all();
         }
-    };
 
-////////////////////////////////////////////////////////////////////////////////
-// slave_slot_holder
-////////////////////////////////////////////////////////////////////////////////
-    class slave_slot_holder : public basic_slot_holder
-    {
-        basic_slot_holder * _master;
+        bool is_connected () const
+        {
+            return _signal.is_connected();
+        }
 
-    public:
-        slave_slot_holder (basic_slot_holder * master) : _master(master) {}
-        virtual bool use_queued_slots () const override { return false; }
-        virtual bool is_slave () const override { return true; }
-        virtual basic_slot_holder * master () const { return _master; }
-    };
+        /**
+         * Output signal, e.g. for emitter table of modulus' module.
+         * It must not be emitted directly.
+         */
+        signal_type & output () noexcept
+        {
+            return _signal;
+        }
 
+        std::size_t emitted_count () const noexcept
+        {
+            return _emitted.load(std::memory_order_relaxed);
+        }
 
-////////////////////////////////////////////////////////////////////////////////
-// signal_base
-////////////////////////////////////////////////////////////////////////////////
+        std::size_t suppressed_count () const noexcept
+        {
+            return _suppressed.load(std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * Signal passing at most one emission per @c interval, other emissions
+     * are dropped at the emitter side (without lock, queue or slot call).
+     */
     template <typename ...Args>
-    class signal_base : public basic_signal
+    class throttled_signal : public signal_adapter_base<Args...>
     {
-    public:
-        using connections_list = std::list<basic_connection<Args...> *>  ;
+        using clock_type = std::chrono::steady_clock;
 
-        signal_base ()
+        clock_type::duration _interval;
+        std::atomic<clock_type::rep> _last;
+
+    public:
+        /**
+         * @param interval Minimal interval between emissions in seconds.
+         */
+        explicit throttled_signal (double interval)
+            : _interval(std::chrono::duration_cast<clock_type::duration>(
+                std::chrono::duration<double>(interval)))
+            , _last((clock_type::now() - _interval).time_since_epoch().count() - 1)
         {}
 
-        ~signal_base ()
+        void emit_signal (Args &&... args)
         {
-            disconnect_all();
+            auto now = clock_type::now().time_since_epoch().count();
+            auto last = _last.load(std::memory_order_relaxed);
+
+            if (now - last < _interval.count()
+                    || !_last.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+                this->_suppressed.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            this->_emitted.fetch_add(1, std::memory_order_relaxed);
+            this->_signal.emit_signal(std::forward<Args>(args)...);
         }
 
-        void disconnect_all ()
+        void operator () (Args &&... args)
         {
-            std::lock_guard<mutex_type> lock(*this);
-            auto it = _connected_slots.begin();
-            auto last = _connected_slots.end();
+            emit_signal(std::forward<Args>(args)...);
+        }
+    };
 
-            while (it != last) {
-                (*it)->get_slot_holder()->signal_disconnect(this);
-                delete *it;
+    /**
+     * Base of timer driven adapters: keeps latest arguments (earlier
+     * pending arguments are counted as suppressed) and emits them from
+     * timer callback.
+     *
+     * TimerService requirements (satisfied by pfs::timer_pool):
+     *      timer_id create (double delay, double period, std::function<void()> && callback);
+     *      destroy (timer_id id); // waits for callback in progress
+     *
+     * Note that slots connected directly are called from timer's thread.
+     */
+    template <typename TimerService, typename ...Args>
+    class timed_signal_base : public signal_adapter_base<Args...>
+    {
+    protected:
+        using timer_id = typename TimerService::timer_id;
+        using clock_type = std::chrono::steady_clock;
+        using payload_type = sigslot_details::payload<Args...>;
+
+        TimerService * _timers {nullptr};
+        double _interval;
+        mutex_type _mtx;
+        payload_type _latest;
+        bool _pending {false};
+        bool _stopped {false};
+        timer_id _timer {0};
 
-                ++it;
-            }
+    protected:
+        timed_signal_base (double interval, TimerService * timers)
+            : _timers(timers)
+            , _interval(interval)
+        {}
 
-            _connected_slots.erase(_connected_slots.begin(), _connected_slots.end());
+        // Derived adapters stop the timer in their destructors (timer
+        // callback uses derived part), here it does nothing unless derived
+        // destructor did not stop it
+        ~timed_signal_base ()
+        {
+            stop();
         }
 
-        void disconnect (basic_slot_holder * pclass)
+        // Must be called with the mutex locked
+        void store (Args &&... args)
         {
-            std::lock_guard<mutex_type> lock(*this);
-            auto it = _connected_slots.begin();
-            auto last = _connected_slots.end();
-
-            while (it != last) {
-                if ((*it)->get_slot_holder() == pclass) {
-                    delete *it;
-                    _connected_slots.erase(it);
-                    pclass->signal_disconnect(this);
-                    return;
-                }
+            if (_pending)
+                this->_suppressed.fetch_add(1, std::memory_order_relaxed);
 
-                ++it;
-            }
+            _latest = payload_type(std::forward<Args>(args)...);
+            _pending = true;
         }
 
-        void slot_disconnect (basic_slot_holder * pslot)
+        // Emits latest arguments if any
+        void emit_latest ()
         {
-            std::lock_guard<mutex_type> lock(*this);
-            auto it = _connected_slots.begin();
-            auto last = _connected_slots.end();
+            std::unique_lock<mutex_type> lock(_mtx);
 
-            while (it != last) {
-                auto next = it;
-                ++next;
+            if (!_pending)
+                return;
 
-                if ((*it)->get_slot_holder() == pslot) {
-                    _connected_slots.erase(it);
-                }
+            payload_type args(std::move(_latest));
+            _pending = false;
+            lock.unlock();
 
-                it = next;
-            }
+            this->_emitted.fetch_add(1, std::memory_order_relaxed);
+            emit_payload(args, sigslot_details::make_index_sequence<sizeof...(Args)>());
         }
 
-        bool is_connected () const
+    private:
+        template <std::size_t ...I>
+        void emit_payload (payload_type & args, sigslot_details::index_sequence<I...>)
         {
-            return _connected_slots.size() > 0;
+            this->_signal.emit_signal(std::forward<Args>(std::get<I>(args))...);
         }
 
-    protected:
-        connections_list _connected_slots;
+    public:
+        /**
+         * Sets timer service, must be called before first emission if
+         * service is not specified in constructor.
+         */
+        void set_timer_service (TimerService * timers)
+        {
+            std::lock_guard<mutex_type> lock(_mtx);
+            assert(_timer == 0);
+            _timers = timers;
+        }
+
+        /**
+         * Stops the timer and drops pending arguments. Waits for the timer
+         * callback in progress. Subsequent emissions are dropped.
+         */
+        void stop ()
+        {
+            timer_id id {0};
+
+            {
+                std::lock_guard<mutex_type> lock(_mtx);
+                _stopped = true;
+                _pending = false;
+                id = _timer;
+                _timer = 0;
+            }
+
+            if (id)
+                _timers->destroy(id);
+        }
     };
 
-////////////////////////////////////////////////////////////////////////////////
-//
-////////////////////////////////////////////////////////////////////////////////
-    template <typename SlotHolderClass, typename ...Args>
-    class connection : public basic_connection<Args...>
+    /**
+     * Signal emitted after quiet period: each emission restarts the period,
+     * only latest arguments are emitted when no emissions happened
+     * during @c interval.
+     */
+    template <typename TimerService, typename ...Args>
+    class debounced_signal : public timed_signal_base<TimerService, Args...>
     {
+        using base_class = timed_signal_base<TimerService, Args...>;
+        using clock_type = std::chrono::steady_clock;
+
+        clock_type::time_point _last_time;
+
     public:
-        connection ()
-            : _pobject(nullptr)
-            , _pmemfun(nullptr)
+        /**
+         * @param interval Quiet period in seconds.
+         */
+        explicit debounced_signal (double interval, TimerService * timers = nullptr)
+            : base_class(interval, timers)
         {}
 
-        connection (SlotHolderClass * pobject, void (SlotHolderClass::*pmemfun)(Args...))
-            : _pobject(pobject)
-            , _pmemfun(pmemfun)
-        {}
+        ~debounced_signal ()
+        {
+            this->stop();
+        }
 
-        virtual void emit_signal (Args const &... args) override
+        void emit_signal (Args &&... args)
         {
-            using method_type = void (SlotHolderClass::*)(Args...);
+            std::lock_guard<mutex_type> lock(this->_mtx);
 
-            if (_pobject->use_queued_slots()) {
-                SlotHolderClass * pobject = _pobject;
-                method_type pmemfun = _pmemfun;
+            if (this->_stopped)
+                return;
 
-                _pobject->callback_queue().push(std::move(pmemfun)
-                        , std::move(pobject)
-                        , args...);
-            } else if (_pobject->is_slave()) {
-                SlotHolderClass * pobject = _pobject;
-                method_type pmemfun = _pmemfun;
+            this->store(std::forward<Args>(args)...);
+            _last_time = clock_type::now();
 
-                _pobject->master()->callback_queue().push(std::move(pmemfun)
-                        , std::move(pobject)
-                        , args...);
-            } else {
-                (_pobject->*_pmemfun)(args...);
-            }
+            // Timer is not restarted on each emission, it checks
+            // the quiet period itself when expired
+            if (this->_timer == 0)
+                start_timer(this->_interval);
         }
 
-        virtual basic_slot_holder * get_slot_holder () const override
+        void operator () (Args &&... args)
         {
-            return _pobject;
+            emit_signal(std::forward<Args>(args)...);
         }
 
     private:
-        SlotHolderClass * _pobject {nullptr};
-        void (SlotHolderClass::* _pmemfun)(Args...);
+        // Must be called with the mutex locked
+        void start_timer (double delay)
+        {
+            assert(this->_timers);
+            this->_timer = this->_timers->create(delay, 0, [this] { on_timeout(); });
+        }
+
+        void on_timeout ()
+        {
+            {
+                std::lock_guard<mutex_type> lock(this->_mtx);
+
+                if (this->_stopped)
+                    return;
+
+                if (!this->_pending) {
+                    this->_timer = 0;
+                    return;
+                }
+
+                auto quiet = std::chrono::duration<double>(clock_type::now() - _last_time).count();
+
+                if (quiet < this->_interval) {
+                    start_timer(this->_interval - quiet);
+                    return;
+                }
+            }
+
+            this->emit_latest();
+
+            // Timer id remains valid until emission finished (stop() waits
+            // for it), restart timer for arguments stored meanwhile
+            std::lock_guard<mutex_type> lock(this->_mtx);
+            this->_timer = 0;
+
+            if (this->_pending && !this->_stopped)
+                start_timer(this->_interval);
+        }
     };
 
-////////////////////////////////////////////////////////////////////////////////
-//
-////////////////////////////////////////////////////////////////////////////////
-    template <typename ...Args>
-    class signal : public signal_base<Args...>
+    /**
+     * Signal emitting latest arguments once per @c interval (if there were
+     * emissions during the interval).
+     */
+    template <typename TimerService, typename ...Args>
+    class sampled_signal : public timed_signal_base<TimerService, Args...>
     {
-        using base_class = signal_base<Args...>;
+        using base_class = timed_signal_base<TimerService, Args...>;
 
     public:
-        signal () {}
+        /**
+         * @param interval Sampling period in seconds.
+         */
+        explicit sampled_signal (double interval, TimerService * timers = nullptr)
+            : base_class(interval, timers)
+        {}
 
-        template <typename SlotHolderClass>
-        void connect (SlotHolderClass * pclass, void (SlotHolderClass::*pmemfun)(Args...))
+        ~sampled_signal ()
         {
-            std::lock_guard<mutex_type> lock(*this);
-            connection<SlotHolderClass, Args...> * conn =
-                    new connection<SlotHolderClass, Args...>(pclass, pmemfun);
-            this->_connected_slots.push_back(conn);
-            pclass->signal_connect(this);
+            this->stop();
         }
 
         void emit_signal (Args &&... args)
         {
-            std::lock_guard<mutex_type> lock(*this);
-            auto it = this->_connected_slots.cbegin();
-            auto last = this->_connected_slots.cend();
+            std::lock_guard<mutex_type> lock(this->_mtx);
 
-            while (it != last) {
-                auto next = it;
-                ++next;
+            if (this->_stopped)
+                return;
 
-                (*it)->emit_signal(args...);
+            this->store(std::forward<Args>(args)...);
 
-                it = next;
+            // Periodic timer is started on first emission
+            if (this->_timer == 0) {
+                assert(this->_timers);
+                this->_timer = this->_timers->create(this->_interval, this->_interval
+                    , [this] { this->emit_latest(); });
             }
         }
 
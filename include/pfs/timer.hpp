@@ -11,6 +11,22 @@
 //
 // Changelog:
 //      2020.01.14 Initial version
+//      2026.10.18 Added fired_count().
+//      2026.10.18 Added timer queue backends (TimerQueue), hierarchical
+//                 timing wheel.
+//      2026.10.18 Added std::chrono overloads of create(), nanosecond
+//                 resolution, spinning before deadline.
+//      2026.10.18 Added timer slack (coalescing of wakeups), wakeups_count().
+//      2026.10.18 Added callback executors (CallbackExecutor).
+//      2026.10.18 Added waiters (Waiter), timerfd waiter and servicing
+//                 timers from external event loop.
+//      2026.10.18 Added missed tick policies of periodic timers.
+//      2026.10.18 Added post_create()/post_destroy() (command inbox),
+//                 lock-free with timerfd waiter, atomic timer IDs.
+//      2026.10.18 Added cancel_async() with completion notification.
+//      2026.10.18 Added pooled allocation of timer nodes (node_pool,
+//                 pooled_timer_associative_container).
+//      2026.10.18 Added timer owners (destroy_all(owner), size(owner)).
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include <algorithm>
@@ -20,295 +36,2112 @@
 #include <unordered_map>
 #include <set>
 #include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <cassert>
 
+#if defined(__linux__)
+#   include <cerrno>
+#   include <ctime>
+#   include <poll.h>
+#   include <sys/eventfd.h>
+#   include <sys/timerfd.h>
+#   include <unistd.h>
+#endif
+
 namespace pfs {
 
-template <typename KeyType, typename ValueType>
-using default_timer_associative_container = std::unordered_map<KeyType, ValueType>;
+namespace timer_details {
+
+/**
+ * Free lists of fixed size blocks (size classes of 16 bytes up to 256
+ * bytes) carved from chunks, so nodes of containers are reused instead of
+ * being allocated per insertion. Larger requests are passed to operator
+ * new. Memory is returned to the system when pool is destroyed only.
+ * Requests passed to operator new are counted (see system_allocations()).
+ *
+ * Not thread safe: containers of the timer pool are accessed under lock.
+ */
+class node_pool
+{
+    struct free_block
+    {
+        free_block * next;
+    };
+
+    enum : std::size_t
+    {
+          granularity = 16
+        , class_count = 16
+        , chunk_blocks = 256
+    };
+
+    free_block * _free[class_count] = {};
+    std::vector<void *> _chunks;
+
+public:
+    node_pool () = default;
+    node_pool (node_pool const &) = delete;
+    node_pool & operator = (node_pool const &) = delete;
+
+    ~node_pool ()
+    {
+        for (auto chunk: _chunks)
+            ::operator delete(chunk);
+    }
+
+    void * allocate (std::size_t size)
+    {
+        auto c = size_class(size);
+
+        if (c >= class_count) {
+            counter().fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+
+        if (!_free[c])
+            refill(c);
+
+        auto block = _free[c];
+        _free[c] = block->next;
+        return block;
+    }
+
+    void deallocate (void * p, std::size_t size) noexcept
+    {
+        auto c = size_class(size);
+
+        if (c >= class_count) {
+            ::operator delete(p);
+            return;
+        }
+
+        auto block = static_cast<free_block *>(p);
+        block->next = _free[c];
+        _free[c] = block;
+    }
+
+    /**
+     * Number of chunks and large blocks requested from operator new by all
+     * pools, it stays the same while pooled containers are in steady state.
+     */
+    static std::uint64_t system_allocations () noexcept
+    {
+        return counter().load(std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<std::uint64_t> & counter () noexcept
+    {
+        static std::atomic<std::uint64_t> value {0};
+        return value;
+    }
+
+    static std::size_t size_class (std::size_t size) noexcept
+    {
+        return size == 0 ? 0 : (size - 1) / granularity;
+    }
+
+    void refill (std::size_t c)
+    {
+        std::size_t block_size = (c + 1) * granularity;
+        auto chunk = static_cast<char *>(::operator new(block_size * chunk_blocks));
+        _chunks.push_back(chunk);
+        counter().fetch_add(1, std::memory_order_relaxed);
+
+        for (std::size_t i = chunk_blocks; i > 0; i--) {
+            auto block = reinterpret_cast<free_block *>(chunk + (i - 1) * block_size);
+            block->next = _free[c];
+            _free[c] = block;
+        }
+    }
+};
+
+/**
+ * Allocator of container nodes from node_pool. Each container (default
+ * constructed allocator) owns its pool, rebound copies share it.
+ */
+template <typename T>
+class pooled_allocator
+{
+    template <typename U>
+    friend class pooled_allocator;
+
+    std::shared_ptr<node_pool> _pool;
+
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = pooled_allocator<U>; };
+
+    pooled_allocator () : _pool(std::make_shared<node_pool>()) {}
+
+    template <typename U>
+    pooled_allocator (pooled_allocator<U> const & other) noexcept
+        : _pool(other._pool)
+    {}
+
+    T * allocate (std::size_t n)
+    {
+        static_assert(alignof(T) <= 16, "Unsupported alignment");
+        return static_cast<T *>(_pool->allocate(n * sizeof(T)));
+    }
+
+    void deallocate (T * p, std::size_t n) noexcept
+    {
+        _pool->deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator == (pooled_allocator<U> const & other) const noexcept
+    {
+        return _pool == other._pool;
+    }
+
+    template <typename U>
+    bool operator != (pooled_allocator<U> const & other) const noexcept
+    {
+        return _pool != other._pool;
+    }
+};
+
+} // namespace timer_details
+
+template <typename KeyType, typename ValueType>
+using default_timer_associative_container = std::unordered_map<KeyType, ValueType>;
+
+/**
+ * Timers storage with nodes reused from the pool, so creation and
+ * destruction of timers does not allocate in steady state.
+ */
+template <typename KeyType, typename ValueType>
+using pooled_timer_associative_container = std::unordered_map<KeyType, ValueType
+    , std::hash<KeyType>
+    , std::equal_to<KeyType>
+    , timer_details::pooled_allocator<std::pair<KeyType const, ValueType>>>;
+
+/**
+ * Timer queue ordered by expiration time (default). Insertion and removal
+ * are O(log n), nodes are reused from the pool.
+ *
+ * Timer queue backend requirements (Item is a timer with `next` time point
+ * and is derived from `hook<Item>`):
+ *      void insert (Item &);
+ *      void erase (Item &);
+ *      bool empty () const;
+ *      std::size_t size () const;
+ *      Item * pop_expired (time_point now); // nullptr if nothing expired
+ *      time_point next_expiry () const;     // worker wakes up at this time
+ */
+struct multiset_timer_queue
+{
+    template <typename Item>
+    struct hook {};
+
+    template <typename Item>
+    class queue
+    {
+        struct next_active_comparator
+        {
+            bool operator () (Item const & a, Item const & b) const noexcept
+            {
+                return a.next < b.next;
+            }
+        };
+
+        using value_type = std::reference_wrapper<Item>;
+        using container_type = std::multiset<value_type, next_active_comparator
+            , timer_details::pooled_allocator<value_type>>;
+
+        container_type _queue;
+
+    public:
+        using time_point_type = decltype(std::declval<Item &>().next);
+
+        void insert (Item & item)
+        {
+            _queue.emplace(item);
+        }
+
+        // Erases exactly this item, not all items with the same expiration
+        // time
+        void erase (Item & item)
+        {
+            auto range = _queue.equal_range(item);
+
+            for (auto it = range.first; it != range.second; ++it) {
+                if (& it->get() == & item) {
+                    _queue.erase(it);
+                    return;
+                }
+            }
+        }
+
+        bool empty () const noexcept { return _queue.empty(); }
+        std::size_t size () const noexcept { return _queue.size(); }
+
+        Item * pop_expired (time_point_type now)
+        {
+            if (_queue.empty())
+                return nullptr;
+
+            auto head = _queue.begin();
+            Item & item = *head;
+
+            if (now < item.next)
+                return nullptr;
+
+            _queue.erase(head);
+            return & item;
+        }
+
+        time_point_type next_expiry () const
+        {
+            assert(!_queue.empty());
+            return _queue.begin()->get().next;
+        }
+    };
+};
+
+namespace timer_details {
+
+inline int lowest_bit (std::uint64_t x) noexcept
+{
+    assert(x != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int i = 0;
+
+    while (!(x & 1)) {
+        x >>= 1;
+        ++i;
+    }
+
+    return i;
+#endif
+}
+
+inline int highest_bit (std::uint64_t x) noexcept
+{
+    assert(x != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(x);
+#else
+    int i = 0;
+
+    while (x >>= 1)
+        ++i;
+
+    return i;
+#endif
+}
+
+/**
+ * Intrusive multiple producers single consumer list of commands.
+ * Producers push nodes by CAS, consumer takes all of them at once, so
+ * neither side blocks. Node requires `Node * next` member.
+ */
+template <typename Node>
+class mpsc_inbox
+{
+    std::atomic<Node *> _head {nullptr};
+
+public:
+    /**
+     * @return @c true if inbox was empty before push (consumer must be
+     *         woken up).
+     */
+    bool push (Node * node) noexcept
+    {
+        auto head = _head.load(std::memory_order_relaxed);
+
+        do {
+            node->next = head;
+        } while (!_head.compare_exchange_weak(head, node));
+
+        return head == nullptr;
+    }
+
+    /**
+     * Takes all pushed nodes in order of pushing.
+     */
+    Node * take_all () noexcept
+    {
+        Node * node = _head.exchange(nullptr);
+        Node * result = nullptr;
+
+        while (node) {
+            auto next = node->next;
+            node->next = result;
+            result = node;
+            node = next;
+        }
+
+        return result;
+    }
+
+    bool empty () const noexcept
+    {
+        return _head.load() == nullptr;
+    }
+};
+
+} // namespace timer_details
+
+/**
+ * Hierarchical timing wheel with @a Tick resolution. Insertion and
+ * removal are O(1) and do not allocate (timers are linked intrusively).
+ *
+ * Wheel has 11 levels of 64 slots covering whole 64-bit range of ticks.
+ * Timer is placed at the level of the highest 6-bit group in which its
+ * expiration tick differs from the current tick, and is moved to lower
+ * levels (cascaded) as current tick reaches its group. Occupancy bitmap
+ * of each level gives next wake up time without scanning slots.
+ *
+ * Timers expired since previous check are fired in unspecified order,
+ * timer never fires earlier than requested and at most one tick later
+ * (plus scheduling latency).
+ */
+template <typename Tick = std::chrono::milliseconds>
+struct basic_timing_wheel_timer_queue
+{
+    template <typename Item>
+    struct hook
+    {
+        Item * wheel_prev {nullptr};
+        Item * wheel_next {nullptr};
+        std::uint64_t wheel_expires {0};
+        std::uint8_t wheel_level {0};
+        std::uint8_t wheel_slot {0};
+    };
+
+    template <typename Item>
+    class queue
+    {
+    public:
+        using time_point_type = decltype(std::declval<Item &>().next);
+
+    private:
+        using clock_type = typename time_point_type::clock;
+        using tick_duration = Tick;
+
+        static constexpr int level_bits = 6;
+        static constexpr int slot_count = 1 << level_bits;
+        static constexpr int level_count = (64 + level_bits - 1) / level_bits;
+        static constexpr std::uint8_t expired_level = 0xFF;
+
+        static_assert(tick_duration::period::num * std::nano::den
+            >= tick_duration::period::den, "Tick must be at least one nanosecond");
+
+        struct list
+        {
+            Item * head {nullptr};
+            Item * tail {nullptr};
+        };
+
+        time_point_type _epoch {clock_type::now()};
+        std::uint64_t _current {0};
+        std::size_t _size {0};
+        std::uint64_t _occupied[level_count];
+        list _slots[level_count][slot_count];
+        list _expired;
+
+    public:
+        queue ()
+        {
+            for (auto & x: _occupied)
+                x = 0;
+        }
+
+        queue (queue const &) = delete;
+        queue & operator = (queue const &) = delete;
+
+        void insert (Item & item)
+        {
+            item.wheel_expires = ticks_ceil(item.next);
+            schedule(item);
+            ++_size;
+        }
+
+        void erase (Item & item)
+        {
+            if (item.wheel_level == expired_level) {
+                unlink(_expired, item);
+            } else {
+                auto & l = _slots[item.wheel_level][item.wheel_slot];
+                unlink(l, item);
+
+                if (!l.head)
+                    _occupied[item.wheel_level] &= ~(std::uint64_t{1} << item.wheel_slot);
+            }
+
+            --_size;
+        }
+
+        bool empty () const noexcept { return _size == 0; }
+        std::size_t size () const noexcept { return _size; }
+
+        Item * pop_expired (time_point_type now)
+        {
+            if (!_expired.head)
+                advance(ticks_floor(now));
+
+            Item * item = _expired.head;
+
+            if (item) {
+                unlink(_expired, *item);
+                --_size;
+            }
+
+            return item;
+        }
+
+        // Expiration time of the nearest timer or time when timers of the
+        // nearest non-empty slot of upper levels must be cascaded
+        time_point_type next_expiry () const
+        {
+            assert(_size > 0);
+
+            if (_expired.head)
+                return _epoch + tick_duration(_current);
+
+            auto result = (std::numeric_limits<std::uint64_t>::max)();
+
+            for (int level = 0; level < level_count; level++) {
+                if (!_occupied[level])
+                    continue;
+
+                int shift = level * level_bits;
+                std::uint64_t group = ((_current >> shift) & ~std::uint64_t{slot_count - 1})
+                    | static_cast<std::uint64_t>(timer_details::lowest_bit(_occupied[level]));
+
+                result = (std::min)(result, group << shift);
+            }
+
+            return _epoch + tick_duration(static_cast<typename tick_duration::rep>(result));
+        }
+
+    private:
+        std::uint64_t ticks_floor (time_point_type t) const
+        {
+            if (t <= _epoch)
+                return 0;
+
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<tick_duration>(t - _epoch).count());
+        }
+
+        std::uint64_t ticks_ceil (time_point_type t) const
+        {
+            if (t <= _epoch)
+                return 0;
+
+            auto ticks = std::chrono::duration_cast<tick_duration>(t - _epoch);
+
+            if (_epoch + ticks < t)
+                ticks += tick_duration(1);
+
+            return static_cast<std::uint64_t>(ticks.count());
+        }
+
+        void schedule (Item & item)
+        {
+            if (item.wheel_expires <= _current) {
+                item.wheel_level = expired_level;
+                link(_expired, item);
+                return;
+            }
+
+            int level = timer_details::highest_bit(item.wheel_expires ^ _current) / level_bits;
+            int slot = static_cast<int>((item.wheel_expires >> (level * level_bits)) & (slot_count - 1));
+
+            item.wheel_level = static_cast<std::uint8_t>(level);
+            item.wheel_slot = static_cast<std::uint8_t>(slot);
+            link(_slots[level][slot], item);
+            _occupied[level] |= std::uint64_t{1} << slot;
+        }
+
+        // Moves current tick to @a now, collects timers of the slots passed
+        // and reschedules them (into expired list or lower levels).
+        void advance (std::uint64_t now)
+        {
+            if (now <= _current)
+                return;
+
+            auto old = _current;
+            _current = now;
+
+            list todo;
+
+            for (int level = 0; level < level_count; level++) {
+                int shift = level * level_bits;
+                std::uint64_t old_group = old >> shift;
+                std::uint64_t new_group = now >> shift;
+
+                // Upper levels are not passed too
+                if (old_group == new_group)
+                    break;
+
+                if (!_occupied[level])
+                    continue;
+
+                // Slots below or equal to current group are empty, so only
+                // slots in range (old_group, new_group] of the block are
+                // passed
+                std::uint64_t pending = ~std::uint64_t{0};
+
+                if (new_group - old_group < slot_count) {
+                    std::uint64_t base = old_group & ~std::uint64_t{slot_count - 1};
+                    std::uint64_t first = (old_group & (slot_count - 1)) + 1;
+                    std::uint64_t last = (std::min)(std::uint64_t{slot_count - 1}, new_group - base);
+
+                    pending = first > last
+                        ? 0
+                        : (~std::uint64_t{0} >> (63 - last)) & ~((std::uint64_t{1} << first) - 1);
+                }
+
+                pending &= _occupied[level];
+                _occupied[level] &= ~pending;
+
+                while (pending) {
+                    int slot = timer_details::lowest_bit(pending);
+                    pending &= pending - 1;
+                    splice(todo, _slots[level][slot]);
+                }
+            }
+
+            while (todo.head) {
+                Item & item = *todo.head;
+                unlink(todo, item);
+                schedule(item);
+            }
+        }
+
+        static void link (list & l, Item & item) noexcept
+        {
+            item.wheel_prev = l.tail;
+            item.wheel_next = nullptr;
+
+            if (l.tail)
+                l.tail->wheel_next = & item;
+            else
+                l.head = & item;
+
+            l.tail = & item;
+        }
+
+        static void unlink (list & l, Item & item) noexcept
+        {
+            if (item.wheel_prev)
+                item.wheel_prev->wheel_next = item.wheel_next;
+            else
+                l.head = item.wheel_next;
+
+            if (item.wheel_next)
+                item.wheel_next->wheel_prev = item.wheel_prev;
+            else
+                l.tail = item.wheel_prev;
+
+            item.wheel_prev = item.wheel_next = nullptr;
+        }
+
+        static void splice (list & to, list & from) noexcept
+        {
+            if (!from.head)
+                return;
+
+            if (to.tail) {
+                to.tail->wheel_next = from.head;
+                from.head->wheel_prev = to.tail;
+            } else {
+                to.head = from.head;
+            }
+
+            to.tail = from.tail;
+            from.head = from.tail = nullptr;
+        }
+    };
+};
+
+using timing_wheel_timer_queue = basic_timing_wheel_timer_queue<>;
+
+/**
+ * Rescheduling of the periodic timer which has fallen behind its schedule
+ * (callback or host stalled).
+ */
+enum class missed_tick_policy
+{
+      catch_up    // Fire missed ticks back-to-back (up to the cap), default
+    , skip        // Fire once, skip missed ticks, keep phase
+    , fixed_delay // Next tick is period after callback completion
+};
+
+/**
+ * Callbacks are executed by the timer thread (default). Slow callback
+ * delays all other timers.
+ *
+ * Callback executor requirements:
+ *      template <typename F> void execute (F && task);
+ *      void stop (); // waits running tasks, pending tasks are discarded
+ */
+class inline_timer_executor
+{
+public:
+    template <typename F>
+    void execute (F && task)
+    {
+        task();
+    }
+
+    void stop () {}
+};
+
+/**
+ * Callbacks are executed by the pool of threads, so timer thread is used
+ * for deadlines management only. Threads are started on first callback.
+ * Callbacks of the same timer never overlap: periodic timer is rescheduled
+ * after its callback returned.
+ */
+class thread_pool_timer_executor
+{
+    using task_type = std::function<void()>;
+
+    mutable std::mutex _mtx;
+    std::condition_variable _cv;
+    std::deque<task_type> _tasks;
+    std::vector<std::thread> _threads;
+    std::size_t _thread_count;
+    bool _stopped {false};
+
+public:
+    explicit thread_pool_timer_executor (std::size_t thread_count = 2)
+        : _thread_count(thread_count)
+    {
+        assert(thread_count > 0);
+    }
+
+    ~thread_pool_timer_executor ()
+    {
+        stop();
+    }
+
+    thread_pool_timer_executor (thread_pool_timer_executor const &) = delete;
+    thread_pool_timer_executor & operator = (thread_pool_timer_executor const &) = delete;
+
+    /**
+     * Sets number of threads, must be called before first callback.
+     */
+    void set_thread_count (std::size_t n)
+    {
+        assert(n > 0);
+        std::lock_guard<std::mutex> lock(_mtx);
+        assert(_threads.empty());
+        _thread_count = n;
+    }
+
+    std::size_t thread_count () const
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        return _thread_count;
+    }
+
+    template <typename F>
+    void execute (F && task)
+    {
+        std::unique_lock<std::mutex> lock(_mtx);
+
+        if (_stopped)
+            return;
+
+        if (_threads.empty()) {
+            for (std::size_t i = 0; i < _thread_count; i++)
+                _threads.emplace_back(& thread_pool_timer_executor::run, this);
+        }
+
+        _tasks.emplace_back(std::forward<F>(task));
+        lock.unlock();
+        _cv.notify_one();
+    }
+
+    void stop ()
+    {
+        std::unique_lock<std::mutex> lock(_mtx);
+
+        if (_stopped)
+            return;
+
+        _stopped = true;
+        _tasks.clear();
+        lock.unlock();
+        _cv.notify_all();
+
+        for (auto & t: _threads)
+            t.join();
+    }
+
+private:
+    void run ()
+    {
+        std::unique_lock<std::mutex> lock(_mtx);
+
+        while (true) {
+            _cv.wait(lock, [this] { return _stopped || !_tasks.empty(); });
+
+            if (_stopped)
+                break;
+
+            auto task = std::move(_tasks.front());
+            _tasks.pop_front();
+
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+};
+
+/**
+ * Timer thread sleeps on condition variable (default).
+ *
+ * Waiter requirements (lock is released while waiting):
+ *      template <typename Locker, typename TimePoint>
+ *      void wait_until (Locker &, TimePoint deadline);
+ *      template <typename Locker> void wait (Locker &); // no deadline
+ *      void notify ();
+ *      int native_handle () const; // -1 if no file descriptor
+ *      template <typename TimePoint> void arm (TimePoint deadline);
+ *      void clear ();              // resets descriptor readiness
+ *      static constexpr bool lock_free_notify; // notify() without lock
+ *                                              // is never lost
+ */
+template <typename ConditionVariable = std::condition_variable>
+class condition_variable_timer_waiter
+{
+    ConditionVariable _cv;
+
+public:
+    // Notification is lost if waiting thread has not entered wait yet
+    static constexpr bool lock_free_notify = false;
+
+    template <typename Locker, typename TimePoint>
+    void wait_until (Locker & locker, TimePoint deadline)
+    {
+        _cv.wait_until(locker, deadline);
+    }
+
+    template <typename Locker>
+    void wait (Locker & locker)
+    {
+        _cv.wait(locker);
+    }
+
+    void notify ()
+    {
+        _cv.notify_all();
+    }
+
+    int native_handle () const noexcept { return -1; }
+
+    template <typename TimePoint>
+    void arm (TimePoint) {}
+
+    void clear () {}
+};
+
+#if defined(__linux__)
+
+/**
+ * Timer thread sleeps in poll() on timerfd (CLOCK_MONOTONIC, armed with
+ * absolute time of the earliest deadline) and eventfd (notifications).
+ * Unlike condition variable there are no spurious wakeups, and timerfd can
+ * be added to external event loop (see timer_pool::use_external_loop()).
+ *
+ * Requires steady clock based on CLOCK_MONOTONIC (true for libstdc++ and
+ * libc++ on Linux).
+ */
+class timerfd_timer_waiter
+{
+    int _tfd {-1};
+    int _efd {-1};
+
+public:
+    // Eventfd stays readable until drained
+    static constexpr bool lock_free_notify = true;
+
+    timerfd_timer_waiter ()
+    {
+        _tfd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        _efd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        assert(_tfd >= 0 && _efd >= 0);
+    }
+
+    ~timerfd_timer_waiter ()
+    {
+        if (_tfd >= 0)
+            ::close(_tfd);
+
+        if (_efd >= 0)
+            ::close(_efd);
+    }
+
+    timerfd_timer_waiter (timerfd_timer_waiter const &) = delete;
+    timerfd_timer_waiter & operator = (timerfd_timer_waiter const &) = delete;
+
+    template <typename Locker, typename TimePoint>
+    void wait_until (Locker & locker, TimePoint deadline)
+    {
+        arm(deadline);
+        locker.unlock();
+        poll_fds();
+        locker.lock();
+    }
+
+    template <typename Locker>
+    void wait (Locker & locker)
+    {
+        settime(0);
+        locker.unlock();
+        poll_fds();
+        locker.lock();
+    }
+
+    void notify ()
+    {
+        std::uint64_t one = 1;
+        auto rc = ::write(_efd, & one, sizeof(one));
+        (void)rc;
+    }
+
+    int native_handle () const noexcept { return _tfd; }
+
+    /**
+     * Arms timerfd to fire at @a deadline (disarms if it is maximum
+     * time point).
+     */
+    template <typename TimePoint>
+    void arm (TimePoint deadline)
+    {
+        if (deadline == (TimePoint::max)()) {
+            settime(0);
+            return;
+        }
+
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            deadline.time_since_epoch()).count();
+
+        // Zero value disarms timer, so expired deadline is set to the
+        // smallest one
+        settime(ns > 0 ? ns : 1);
+    }
+
+    void clear ()
+    {
+        drain(_tfd);
+    }
+
+private:
+    // Absolute CLOCK_MONOTONIC time in nanoseconds, zero disarms
+    void settime (std::int64_t ns)
+    {
+        itimerspec spec {};
+        spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+        spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+
+        auto rc = ::timerfd_settime(_tfd, TFD_TIMER_ABSTIME, & spec, nullptr);
+        assert(rc == 0);
+        (void)rc;
+    }
+
+    void poll_fds ()
+    {
+        pollfd fds[2];
+        fds[0].fd = _tfd;
+        fds[0].events = POLLIN;
+        fds[1].fd = _efd;
+        fds[1].events = POLLIN;
+
+        while (::poll(fds, 2, -1) < 0 && errno == EINTR)
+            ;
+
+        drain(_tfd);
+        drain(_efd);
+    }
+
+    static void drain (int fd)
+    {
+        std::uint64_t value;
+
+        while (::read(fd, & value, sizeof(value)) > 0)
+            ;
+    }
+};
+
+#endif
+
+template <template <typename, typename> class AssociativeContainer = default_timer_associative_container
+        , typename BasicLockable = std::mutex
+        , typename ConditionVariable = std::condition_variable
+        , template <typename> class ScopedLocker = std::unique_lock
+        , typename TimerQueue = multiset_timer_queue
+        , typename CallbackExecutor = inline_timer_executor
+        , typename Waiter = condition_variable_timer_waiter<ConditionVariable>>
+class timer_pool
+{
+public: // Public types
+    using timer_id = uint32_t;
+
+    // Group of timers (e.g. module) destroyed together, nullptr if none
+    using timer_owner = void const *;
+
+    // Function object we actually use
+    using callback_type = std::function<void()>;
+
+    using executor_type = CallbackExecutor;
+    using waiter_type = Waiter;
+
+private: // Private types
+    using mutex_type = BasicLockable;
+    using condition_variable_type = ConditionVariable;
+    using locker_type = ScopedLocker<mutex_type>;
+    using clock_type = std::chrono::steady_clock;
+    using duration_type = std::chrono::nanoseconds;
+    using time_point_type = std::chrono::time_point<clock_type, duration_type>;
+
+    // Timer
+    struct timer_item : TimerQueue::template hook<timer_item>
+    {
+        timer_id id = 0;
+        time_point_type next;   // Expiration time (coalesced), queue key
+        time_point_type due;    // Requested expiration time
+        duration_type period;
+        duration_type slack;
+        callback_type callback;
+        bool running = false;
+        bool cancelled = false; // Destroyed while callback is running
+
+        // Thread executing the callback, set when executor has started it
+        std::thread::id runner;
+
+        // Timers of the same owner are linked (see owner_list)
+        timer_owner owner = nullptr;
+        timer_item * owner_prev = nullptr;
+        timer_item * owner_next = nullptr;
+        missed_tick_policy policy = missed_tick_policy::catch_up;
+        std::uint32_t max_catch_up = 0;
+        std::uint64_t missed = 0;
+
+        // You must be holding the 'sync' lock to assign wait_cv
+        std::unique_ptr<condition_variable_type> wait_cv;
+
+        // Called when callback cancelled by cancel_async() has returned
+        callback_type on_cancelled;
+
+        explicit timer_item (timer_id tid = 0) : id(tid) { }
+
+        timer_item (timer_item && r) noexcept
+            : id(r.id)
+            , next(r.next)
+            , due(r.due)
+            , period(r.period)
+            , slack(r.slack)
+            , callback(std::move(r.callback))
+            , running(r.running)
+            , cancelled(r.cancelled)
+            , policy(r.policy)
+            , max_catch_up(r.max_catch_up)
+            , missed(r.missed)
+        {}
+
+        timer_item & operator = (timer_item && r) noexcept;
+
+        timer_item (timer_id tid
+                , time_point_type tdue
+                , duration_type tperiod
+                , duration_type tslack
+                , callback_type && func) noexcept
+            : id(tid)
+            , next(coalesce(tdue, tslack))
+            , due(tdue)
+            , period(tperiod)
+            , slack(tslack)
+            , callback(std::move(func))
+        {}
+
+        timer_item (timer_item const &) = delete;
+        timer_item & operator = (timer_item const &) = delete;
+    };
+
+    using timer_map = AssociativeContainer<timer_id, timer_item>;
+
+    struct owner_list
+    {
+        timer_item * head = nullptr;
+        std::size_t size = 0;
+    };
+
+    using owner_map = AssociativeContainer<timer_owner, owner_list>;
+
+    // Queue holds references to timer_item objects ordered by next
+    using timer_queue = typename TimerQueue::template queue<timer_item>;
+
+    // Request posted by post_create() or post_destroy()
+    struct timer_command
+    {
+        timer_command * next = nullptr;
+        timer_id id;
+        bool cancel;
+        timer_owner owner = nullptr;
+        time_point_type due;
+        duration_type period;
+        duration_type slack;
+        callback_type callback;
+    };
+
+    using command_inbox = timer_details::mpsc_inbox<timer_command>;
+
+
+private: // Private members
+    // One worker thread for an unlimited number of timers is acceptable
+    // Lazily started when first timer is started
+    // TODO: Implement auto-stopping the timer thread when it is idle for
+    // a configurable period.
+    mutable mutex_type _mtx;
+    std::thread _worker;
+
+    // Inexhaustible source of unique IDs
+    std::atomic<timer_id> _next_id;
+
+    // Requests posted without locking, processed by timer thread
+    command_inbox _inbox;
+
+    // Worker thread is started (or external loop is used)
+    std::atomic_bool _started{false};
+
+    // The Timer objects are physically stored in this map
+    timer_map _active;
+
+    // The ordering queue holds references to items in '_active'
+    timer_queue _queue;
+
+    // Timers grouped by owner
+    owner_map _owners;
+
+    waiter_type _waiter;
+
+    // Timers are serviced by external loop (see process_expired())
+    bool _external {false};
+
+    // Thread servicing timers (worker or caller of process_expired())
+    std::thread::id _service_thread;
+
+    std::atomic_bool _done{false};
+
+    // Incremented when worker must recalculate its deadline (interrupts
+    // spinning)
+    std::atomic<std::uint64_t> _wakeup_seq{0};
+
+    // Worker spins this time before deadline instead of sleeping
+    duration_type _spin_threshold{0};
+
+    // Slack of timers created without explicit one
+    duration_type _default_slack{0};
+
+    // Number of worker wakeups
+    std::atomic<std::uint64_t> _wakeups{0};
+
+    // Executes callbacks of the expired timers
+    executor_type _executor;
+
+    // Number of callbacks called
+    std::atomic<std::uint64_t> _fired{0};
+
+    // Missed tick policy of timers created without explicit one
+    missed_tick_policy _default_policy{missed_tick_policy::catch_up};
+    std::uint32_t _default_max_catch_up{unlimited_catch_up};
+
+    // Number of ticks skipped by all timers
+    std::atomic<std::uint64_t> _missed{0};
+
+    // Valid IDs are guaranteed not to be this value
+    static timer_id constexpr no_timer = timer_id{0};
+
+public:
+    // Maximum number of missed ticks fired back-to-back (no limit)
+    static constexpr std::uint32_t unlimited_catch_up = (std::numeric_limits<std::uint32_t>::max)();
+
+public:
+    // Constructor does not start worker until there is a Timer.
+    timer_pool () : _next_id(no_timer + 1)
+    {}
+
+    // Destructor is thread safe, even if a timer callback is running.
+    // All callbacks are guaranteed to have returned before this
+    // destructor returns.
+    ~timer_pool ()
+    {
+        locker_type locker(_mtx);
+
+        // The worker might not be running
+        if (_worker.joinable()) {
+            _done = true;
+            locker.unlock();
+            _waiter.notify();
+
+            // If a timer callback is running, this
+            // will make sure it has returned before
+            // allowing any deallocations to happen
+            _worker.join();
+
+            // Note that any timers still in the queue
+            // will be destructed properly but they
+            // will not be invoked
+        } else {
+            locker.unlock();
+        }
+
+        _executor.stop();
+
+        // Posted requests not processed yet
+        auto cmd = _inbox.take_all();
+
+        while (cmd) {
+            std::unique_ptr<timer_command> guard(cmd);
+            cmd = cmd->next;
+        }
+    }
+
+    /**
+      Create a new timer, and add it to the internal queue.
+
+      @param delay  Callback starts firing this many seconds from now
+      @param period If non-zero, callback is fired again after this period
+      @param func   The callback to run at the specified interval
+
+      @return  Id used to identify the timer for later use
+    */
+    timer_id create (double delay
+            , double period
+            , callback_type && func)
+    {
+        return create_impl(clock_type::now() + seconds_to_duration(delay)
+            , seconds_to_duration(period)
+            , default_slack()
+            , std::forward<callback_type>(func));
+    }
+
+    /**
+      Create a new timer firing after @a delay, then every @a period
+      if it is non-zero. Resolution is one nanosecond.
+    */
+    template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+    timer_id create (std::chrono::duration<Rep1, Period1> delay
+            , std::chrono::duration<Rep2, Period2> period
+            , callback_type && func)
+    {
+        assert(delay.count() >= 0 && period.count() >= 0);
+
+        return create_impl(clock_type::now() + std::chrono::duration_cast<duration_type>(delay)
+            , std::chrono::duration_cast<duration_type>(period)
+            , default_slack()
+            , std::forward<callback_type>(func));
+    }
+
+    /**
+      Create a new timer allowed to fire up to @a slack later than
+      requested, so timers with close expiration times are fired by single
+      wakeup of the worker.
+    */
+    template <typename Rep1, typename Period1, typename Rep2, typename Period2
+        , typename Rep3, typename Period3>
+    timer_id create (std::chrono::duration<Rep1, Period1> delay
+            , std::chrono::duration<Rep2, Period2> period
+            , std::chrono::duration<Rep3, Period3> slack
+            , callback_type && func)
+    {
+        assert(delay.count() >= 0 && period.count() >= 0 && slack.count() >= 0);
+
+        return create_impl(clock_type::now() + std::chrono::duration_cast<duration_type>(delay)
+            , std::chrono::duration_cast<duration_type>(period)
+            , std::chrono::duration_cast<duration_type>(slack)
+            , std::forward<callback_type>(func));
+    }
+
+    /**
+      Create a new timer belonging to @a owner (see destroy_all(owner)).
+    */
+    timer_id create (timer_owner owner
+            , double delay
+            , double period
+            , callback_type && func)
+    {
+        return create_impl(clock_type::now() + seconds_to_duration(delay)
+            , seconds_to_duration(period)
+            , default_slack()
+            , std::forward<callback_type>(func)
+            , owner);
+    }
+
+    /**
+      Create a new timer belonging to @a owner (see destroy_all(owner)).
+    */
+    template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+    timer_id create (timer_owner owner
+            , std::chrono::duration<Rep1, Period1> delay
+            , std::chrono::duration<Rep2, Period2> period
+            , callback_type && func)
+    {
+        assert(delay.count() >= 0 && period.count() >= 0);
+
+        return create_impl(clock_type::now() + std::chrono::duration_cast<duration_type>(delay)
+            , std::chrono::duration_cast<duration_type>(period)
+            , default_slack()
+            , std::forward<callback_type>(func)
+            , owner);
+    }
+
+    /**
+      Create a new timer firing at time point @a at, then every @a period
+      if it is non-zero.
+    */
+    template <typename Duration, typename Rep, typename Period>
+    timer_id create (std::chrono::time_point<clock_type, Duration> at
+            , std::chrono::duration<Rep, Period> period
+            , callback_type && func)
+    {
+        assert(period.count() >= 0);
+
+        return create_impl(std::chrono::time_point_cast<duration_type>(at)
+            , std::chrono::duration_cast<duration_type>(period)
+            , default_slack()
+            , std::forward<callback_type>(func));
+    }
+
+    /**
+      Same as create(delay, period, func), but the timer is created by
+      timer thread from the command inbox. Returned ID is valid immediately
+      (e.g. for post_destroy() or destroy()). Default slack and missed tick
+      policy are applied when the command is processed.
+
+      Does not take the pool's lock with timerfd_timer_waiter only (and
+      with external loop). The default waiter takes the lock briefly on
+      each post to the empty inbox to notify the worker, first call starts
+      the worker under the lock. Each call allocates a command.
+    */
+    template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+    timer_id post_create (std::chrono::duration<Rep1, Period1> delay
+            , std::chrono::duration<Rep2, Period2> period
+            , callback_type && func)
+    {
+        return post_create(delay, period, default_slack()
+            , std::forward<callback_type>(func));
+    }
+
+    /**
+      Same as create(delay, period, slack, func), but the timer is created
+      by timer thread (see post_create(delay, period, func)).
+    */
+    template <typename Rep1, typename Period1, typename Rep2, typename Period2
+        , typename Rep3, typename Period3>
+    timer_id post_create (std::chrono::duration<Rep1, Period1> delay
+            , std::chrono::duration<Rep2, Period2> period
+            , std::chrono::duration<Rep3, Period3> slack
+            , callback_type && func)
+    {
+        assert(delay.count() >= 0 && period.count() >= 0);
+
+        if (!_external && !_started.load(std::memory_order_acquire))
+            start_worker();
+
+        std::unique_ptr<timer_command> cmd(new timer_command);
+        cmd->id = _next_id.fetch_add(1, std::memory_order_relaxed);
+        cmd->cancel = false;
+        cmd->due = clock_type::now() + std::chrono::duration_cast<duration_type>(delay);
+        cmd->period = std::chrono::duration_cast<duration_type>(period);
+        cmd->slack = std::chrono::duration_cast<duration_type>(slack);
+        cmd->callback = std::forward<callback_type>(func);
+
+        auto id = cmd->id;
+        post(cmd.release());
+        return id;
+    }
+
+    /**
+      Destroys timer without waiting for running callback: the callback
+      will not be called after the command is processed by timer thread,
+      but may be running when (or started shortly after) this call returns.
+      Locking and allocation are the same as for post_create().
+    */
+    void post_destroy (timer_id id)
+    {
+        std::unique_ptr<timer_command> cmd(new timer_command);
+        cmd->id = id;
+        cmd->cancel = true;
+        post(cmd.release());
+    }
+
+    /**
+      Sets slack of timers created without explicit one (zero by default).
+      Affects timers created after this call.
+    */
+    void set_default_slack (duration_type slack)
+    {
+        assert(slack.count() >= 0);
+
+        locker_type locker(_mtx);
+        _default_slack = slack;
+    }
+
+    /**
+      Sets time before deadline the worker spins (yielding) instead of
+      sleeping on condition variable. Sleeping wakes up tens of microseconds
+      late, spinning gives sub-millisecond accuracy at the cost of CPU time.
+      Zero (default) disables spinning.
+    */
+    void set_spin_threshold (duration_type threshold)
+    {
+        assert(threshold.count() >= 0);
+
+        locker_type locker(_mtx);
+        _spin_threshold = threshold;
+        notify_worker(locker);
+    }
+
+    /**
+      Timers will be serviced by external event loop instead of the pool's
+      thread: loop waits for readability of native_handle() and calls
+      process_expired(). Must be called before first timer is created,
+      requires waiter with file descriptor (e.g. timerfd_timer_waiter).
+    */
+    void use_external_loop ()
+    {
+        locker_type locker(_mtx);
+        assert(!_worker.joinable());
+        assert(_waiter.native_handle() >= 0);
+        _external = true;
+    }
+
+    /**
+      File descriptor readable when the earliest timer expires
+      (-1 if waiter has no descriptor).
+    */
+    int native_handle () const noexcept
+    {
+        return _waiter.native_handle();
+    }
+
+    /**
+      Fires expired timers from the calling thread (callbacks are passed to
+      the executor) and rearms descriptor for the next deadline.
+
+      @return Number of fired timers.
+    */
+    std::size_t process_expired ()
+    {
+        locker_type locker(_mtx);
+        assert(_external);
+
+        _service_thread = std::this_thread::get_id();
+        _waiter.clear();
+        drain_inbox();
+
+        std::size_t count = 0;
+        auto now = clock_type::now();
+
+        while (timer_item * expired = _queue.pop_expired(now)) {
+            fire(locker, *expired);
+            ++count;
+        }
+
+        arm_waiter();
+
+        // Command posted after draining, its producer may have armed
+        // descriptor before arm_waiter()
+        if (!_inbox.empty())
+            _waiter.arm(time_point_type{});
+
+        return count;
+    }
+
+    /**
+      Destroy the specified timer.
+
+      Synchronizes with the worker thread if the callback for this timer
+      is running, which guarantees that the callback for that callback is
+      not running before clear() returns.
+
+      You are not required to clear any timers. You can forget their
+      TimerId if you do not need to cancel them.
+
+      The only time you need this is when you want to stop a timer that
+      has a repetition period, or you want to cancel a timeout that has
+      not fired yet.
+    */
+    bool destroy (timer_id id)
+    {
+        locker_type locker(_mtx);
+        drain_inbox();
+        auto it = _active.find(id);
+        return destroy_impl(locker, it, true);
+    }
+
+    /**
+      Cancels the timer without waiting for its running callback. When this
+      call returns the callback will not be started again (the running one,
+      if any, completes).
+
+      @a completion (optional) is called when the callback is guaranteed
+      not to run anymore: immediately from the calling thread if callback
+      is not running, otherwise from the thread that executed the callback,
+      after it has returned. Until completion is called, state captured by
+      the callback must stay alive; without completion use destroy() if
+      captured state is going to be destroyed by the caller.
+
+      Safe to call from the timer's own callback.
+
+      @return @c false if timer not found (completion is not called).
+    */
+    bool cancel_async (timer_id id, callback_type && completion = callback_type{})
+    {
+        locker_type locker(_mtx);
+        drain_inbox();
+        auto it = _active.find(id);
+
+        if (it == _active.end())
+            return false;
+
+        timer_item & timer = it->second;
+
+        if (in_callback(timer)) {
+            if (timer.on_cancelled && completion) {
+                // Cancelled repeatedly while callback is running
+                callback_type first = std::move(timer.on_cancelled);
+                timer.on_cancelled = [first, completion] { first(); completion(); };
+            } else if (completion) {
+                timer.on_cancelled = std::move(completion);
+            }
+
+            cancel_impl(timer);
+            return true;
+        }
+
+        cancel_impl(timer);
+        locker.unlock();
+
+        if (completion)
+            completion();
+
+        return true;
+    }
+
+    /**
+      Destroy all timers, but preserve id uniqueness.
+      This carefully makes sure every timer is not executing its callback
+      before destructing it.
+    */
+    void destroy_all ()
+    {
+        locker_type locker(_mtx);
+        drain_inbox();
+
+        // Idle timers are removed at once, running ones are flagged for
+        // removal by complete()
+        for (auto it = _active.begin(); it != _active.end();) {
+            auto next = it;
+            ++next;
+            cancel_impl(it->second);
+            it = next;
+        }
+
+        // Wait for callbacks running by other threads
+        while (true) {
+            auto it = _active.begin();
+
+            while (it != _active.end() && !must_wait(it->second))
+                ++it;
+
+            if (it == _active.end())
+                break;
+
+            destroy_impl(locker, it, false);
+        }
+    }
+
+    /**
+      Destroy all timers of the @a owner in O(k), k is the number of its
+      timers. Like destroy(), waits for callbacks running by other threads
+      (callback which is not started yet will not be called).
+
+      @return Number of destroyed timers.
+    */
+    std::size_t destroy_all (timer_owner owner)
+    {
+        assert(owner != nullptr);
+
+        locker_type locker(_mtx);
+        drain_inbox();
+        auto it = _owners.find(owner);
+
+        if (it == _owners.end())
+            return 0;
+
+        auto count = it->second.size;
+
+        // Idle timers are removed at once, running ones are flagged for
+        // removal by complete() (owner's entry is erased with last timer)
+        timer_item * timer = it->second.head;
+
+        while (timer) {
+            auto next = timer->owner_next;
+            cancel_impl(*timer);
+            timer = next;
+        }
+
+        // Wait for callbacks running by other threads
+        while (true) {
+            it = _owners.find(owner);
+
+            if (it == _owners.end())
+                break;
+
+            timer = it->second.head;
+
+            while (timer && !must_wait(*timer))
+                timer = timer->owner_next;
+
+            if (!timer)
+                break;
+
+            destroy_impl(locker, _active.find(timer->id), false);
+        }
+
+        return count;
+    }
+
+    std::size_t size () const noexcept
+    {
+        locker_type locker(_mtx);
+        return _active.size();
+    }
+
+    /**
+      Number of timers of the @a owner.
+    */
+    std::size_t size (timer_owner owner) const
+    {
+        locker_type locker(_mtx);
+        auto it = _owners.find(owner);
+        return it == _owners.end() ? 0 : it->second.size;
+    }
+
+    bool empty () const noexcept
+    {
+        locker_type locker(_mtx);
+        return _active.empty();
+    }
+
+    std::uint64_t fired_count () const noexcept
+    {
+        return _fired.load(std::memory_order_relaxed);
+    }
+
+    /**
+      Sets missed tick policy of periodic timers created after this call.
+      @a max_catch_up limits number of missed ticks fired back-to-back
+      by catch_up policy, the rest are skipped.
+    */
+    void set_default_missed_tick_policy (missed_tick_policy policy
+        , std::uint32_t max_catch_up = unlimited_catch_up)
+    {
+        locker_type locker(_mtx);
+        _default_policy = policy;
+        _default_max_catch_up = max_catch_up;
+    }
+
+    /**
+      Sets missed tick policy of the timer @a id.
+
+      @return @c false if timer not found.
+    */
+    bool set_missed_tick_policy (timer_id id, missed_tick_policy policy
+        , std::uint32_t max_catch_up = unlimited_catch_up)
+    {
+        locker_type locker(_mtx);
+        drain_inbox();
+        auto it = _active.find(id);
+
+        if (it == _active.end())
+            return false;
+
+        it->second.policy = policy;
+        it->second.max_catch_up = max_catch_up;
+        return true;
+    }
+
+    /**
+      Number of ticks skipped by the timer @a id (zero if timer not found).
+    */
+    std::uint64_t missed_ticks (timer_id id) const
+    {
+        locker_type locker(_mtx);
+        auto it = _active.find(id);
+        return it == _active.end() ? 0 : it->second.missed;
+    }
 
-template <template <typename, typename> class AssociativeContainer = default_timer_associative_container
-        , typename BasicLockable = std::mutex
-        , typename ConditionVariable = std::condition_variable
-        , template <typename> class ScopedLocker = std::unique_lock>
-class timer_pool
-{
-public: // Public types
-    using timer_id = uint32_t;
+    /**
+      Number of ticks skipped by all timers.
+    */
+    std::uint64_t missed_ticks_count () const noexcept
+    {
+        return _missed.load(std::memory_order_relaxed);
+    }
 
-    // Function object we actually use
-    using callback_type = std::function<void()>;
+    /**
+      Number of times the worker woke up (by timeout or notification).
+    */
+    std::uint64_t wakeups_count () const noexcept
+    {
+        return _wakeups.load(std::memory_order_relaxed);
+    }
 
-private: // Private types
-    using mutex_type = BasicLockable;
-    using condition_variable_type = ConditionVariable;
-    using locker_type = ScopedLocker<mutex_type>;
-    using clock_type = std::chrono::steady_clock;
-    using time_point_type = std::chrono::time_point<clock_type>;
-    using duration_millis_type = std::chrono::milliseconds;
+    /**
+      Executor of the callbacks (e.g. to configure it before first timer
+      is created).
+    */
+    executor_type & executor () noexcept
+    {
+        return _executor;
+    }
 
-    // Timer
-    struct timer_item
+private:
+    // Marks timer using pool's default slack
+    static duration_type default_slack () noexcept
     {
-        timer_id id = 0;
-        time_point_type next;
-        duration_millis_type period;
-        callback_type callback;
-        bool running = false;
+        return duration_type(-1);
+    }
 
-        // You must be holding the 'sync' lock to assign wait_cv
-        std::unique_ptr<condition_variable_type> wait_cv;
+    // Rounds expiration time up to the grid step, which is the largest
+    // power of two not greater than slack, so expiration times within
+    // same step are coalesced and timer fires at most slack later.
+    static time_point_type coalesce (time_point_type due, duration_type slack)
+    {
+        auto t = due.time_since_epoch().count();
 
-        explicit timer_item (timer_id tid = 0) : id(tid) { }
+        if (slack.count() <= 0 || t < 0)
+            return due;
 
-        timer_item (timer_item && r) noexcept
-            : id(r.id)
-            , next(r.next)
-            , period(r.period)
-            , callback(std::move(r.callback))
-            , running(r.running)
-        {}
+        auto step = duration_type::rep{1}
+            << timer_details::highest_bit(static_cast<std::uint64_t>(slack.count()));
 
-        timer_item & operator = (timer_item && r) noexcept;
+        assert(t <= (std::numeric_limits<duration_type::rep>::max)() - step);
 
-        timer_item (timer_id tid
-                , time_point_type tnext
-                , duration_millis_type tperiod
-                , callback_type && func) noexcept
-            : id(tid)
-            , next(tnext)
-            , period(tperiod)
-            , callback(std::move(func))
-        {}
+        return time_point_type(duration_type((t + step - 1) / step * step));
+    }
 
-        timer_item (timer_item const &) = delete;
-        timer_item & operator = (timer_item const &) = delete;
-    };
+    static duration_type seconds_to_duration (double seconds)
+    {
+        assert(seconds >= 0);
+        assert(seconds <= std::chrono::duration_cast<std::chrono::duration<double>>(
+            duration_type::max()).count());
 
-    // Comparison functor to sort the timer "queue" by Timer::next
-    struct next_active_comparator
+        return std::chrono::duration_cast<duration_type>(
+            std::chrono::duration<double>(seconds));
+    }
+
+    timer_id create_impl (time_point_type due
+            , duration_type period
+            , duration_type slack
+            , callback_type && func
+            , timer_owner owner = nullptr)
     {
-        bool operator () (timer_item const & a, timer_item const & b) const noexcept
-        {
-            return a.next < b.next;
-        }
-    };
+        locker_type locker(_mtx);
 
-    using timer_map = AssociativeContainer<timer_id, timer_item>;
+        // Lazily start thread when first timer is requested
+        if (!_external && !_worker.joinable()) {
+            _worker = std::thread(& timer_pool::worker, this);
+            _started.store(true, std::memory_order_release);
+        }
 
-    // Queue is a set of references to timer_item objects, sorted by next
-    using value_type = std::reference_wrapper<timer_item>;
-    using timer_queue = std::multiset<value_type, next_active_comparator>;
+        // Assign an ID and insert it into function storage
+        auto id = _next_id.fetch_add(1, std::memory_order_relaxed);
 
+        // We need to notify the timer thread only if this timer
+        // expires earlier than the worker wakes up
+        if (insert_impl(id, due, period, slack, std::forward<callback_type>(func), owner))
+            notify_worker(locker);
 
-private: // Private members
-    // One worker thread for an unlimited number of timers is acceptable
-    // Lazily started when first timer is started
-    // TODO: Implement auto-stopping the timer thread when it is idle for
-    // a configurable period.
-    mutable mutex_type _mtx;
-    std::thread _worker;
+        return id;
+    }
 
-    // Inexhaustible source of unique IDs
-    timer_id _next_id;
+    // Inserts timer into storage and ordering queue, returns true if it
+    // expires earlier than any other
+    bool insert_impl (timer_id id
+            , time_point_type due
+            , duration_type period
+            , duration_type slack
+            , callback_type && func
+            , timer_owner owner)
+    {
+        if (slack == default_slack())
+            slack = _default_slack;
 
-    // The Timer objects are physically stored in this map
-    timer_map _active;
+        auto iter = _active.emplace(id
+                , timer_item(id
+                        , due
+                        , period
+                        , slack
+                        , std::forward<callback_type>(func)));
 
-    // The ordering queue holds references to items in '_active'
-    timer_queue _queue;
+        timer_item & timer = iter.first->second;
+        timer.policy = _default_policy;
+        timer.max_catch_up = _default_max_catch_up;
 
-    condition_variable_type _wakeup_cv;
+        if (owner)
+            link_owner(timer, owner);
 
-    std::atomic_bool _done{false};
+        bool earliest = _queue.empty() || timer.next < _queue.next_expiry();
 
-    // Valid IDs are guaranteed not to be this value
-    static timer_id constexpr no_timer = timer_id{0};
+        // Insert a reference to the Timer into ordering queue
+        _queue.insert(timer);
 
-public:
-    // Constructor does not start worker until there is a Timer.
-    timer_pool () : _next_id(no_timer + 1)
-    {}
+        return earliest;
+    }
 
-    // Destructor is thread safe, even if a timer callback is running.
-    // All callbacks are guaranteed to have returned before this
-    // destructor returns.
-    ~timer_pool ()
+    void start_worker ()
     {
         locker_type locker(_mtx);
 
-        // The worker might not be running
-        if (_worker.joinable()) {
-            _done = true;
-            locker.unlock();
-            _wakeup_cv.notify_all();
+        if (!_worker.joinable()) {
+            _worker = std::thread(& timer_pool::worker, this);
+            _started.store(true, std::memory_order_release);
+        }
+    }
 
-            // If a timer callback is running, this
-            // will make sure it has returned before
-            // allowing any deallocations to happen
-            _worker.join();
+    // Pushes command into inbox and wakes up timer thread if inbox was
+    // empty
+    void post (timer_command * cmd)
+    {
+        if (!_inbox.push(cmd))
+            return;
 
-            // Note that any timers still in the queue
-            // will be destructed properly but they
-            // will not be invoked
+        if (_external) {
+            // Descriptor becomes readable immediately
+            _waiter.arm(time_point_type{});
+        } else {
+            _wakeup_seq.fetch_add(1, std::memory_order_release);
+
+            // Worker may be between draining inbox and waiting on condition
+            // variable (both under lock)
+            if (!waiter_type::lock_free_notify) {
+                locker_type locker(_mtx);
+            }
+
+            _waiter.notify();
         }
     }
 
-    /**
-      Create a new timer using milliseconds, and add it to the internal queue.
+    // Processes posted commands, must be called under lock
+    void drain_inbox ()
+    {
+        auto cmd = _inbox.take_all();
+        bool earliest = false;
 
-      @param delay  Callback starts firing this many seconds from now
-      @param period If non-zero, callback is fired again after this period
-      @param func   The callback to run at the specified interval
+        while (cmd) {
+            std::unique_ptr<timer_command> guard(cmd);
+            cmd = cmd->next;
 
-      @return  Id used to identify the timer for later use
-    */
-    timer_id create (double delay
-            , double period
-            , callback_type && func)
+            if (guard->cancel) {
+                auto it = _active.find(guard->id);
+
+                if (it != _active.end())
+                    cancel_impl(it->second);
+            } else {
+                earliest = insert_impl(guard->id, guard->due, guard->period
+                    , guard->slack, std::move(guard->callback), guard->owner) || earliest;
+            }
+        }
+
+        // Timer thread recalculates deadline itself
+        if (earliest && std::this_thread::get_id() != _service_thread) {
+            if (_external) {
+                arm_waiter();
+            } else {
+                _wakeup_seq.fetch_add(1, std::memory_order_release);
+                _waiter.notify();
+            }
+        }
+    }
+
+    void link_owner (timer_item & timer, timer_owner owner)
     {
-        locker_type locker(_mtx);
+        owner_list & list = _owners[owner];
+        timer.owner = owner;
+        timer.owner_next = list.head;
 
-        // Lazily start thread when first timer is requested
-        if (!_worker.joinable())
-            _worker = std::thread(& timer_pool::worker, this);
+        if (list.head)
+            list.head->owner_prev = & timer;
 
-        // Assign an ID and insert it into function storage
-        auto id = _next_id++;
+        list.head = & timer;
+        ++list.size;
+    }
 
-        assert(delay * 1000 <= static_cast<decltype(delay)>(std::numeric_limits<intmax_t>::max()));
-        assert(period * 1000 <= static_cast<decltype(period)>(std::numeric_limits<intmax_t>::max()));
-        auto delay_millis = duration_millis_type(static_cast<intmax_t>(delay * 1000));
-        auto period_millis = duration_millis_type(static_cast<intmax_t>(period * 1000));
+    void unlink_owner (timer_item & timer)
+    {
+        auto it = _owners.find(timer.owner);
+        assert(it != _owners.end());
+        owner_list & list = it->second;
 
-        auto iter = _active.emplace(id
-                , timer_item(id
-                        , clock_type::now() + delay_millis
-                        , period_millis
-                        , std::forward<callback_type>(func)));
+        if (timer.owner_prev)
+            timer.owner_prev->owner_next = timer.owner_next;
+        else
+            list.head = timer.owner_next;
 
-        // Insert a reference to the Timer into ordering queue
-        typename timer_queue::iterator place = _queue.emplace(iter.first->second);
+        if (timer.owner_next)
+            timer.owner_next->owner_prev = timer.owner_prev;
 
-        // We need to notify the timer thread only if we inserted
-        // this timer into the front of the timer queue
-        bool needNotify = (place == _queue.begin());
+        if (--list.size == 0)
+            _owners.erase(it);
+    }
 
-        locker.unlock();
+    // Removes timer from storage (it must not be in the ordering queue)
+    void erase_timer (timer_item & timer)
+    {
+        if (timer.owner)
+            unlink_owner(timer);
 
-        if (needNotify)
-            _wakeup_cv.notify_all();
+        _active.erase(timer.id);
+    }
 
-        return id;
+    // Removes timer without waiting for its running callback
+    void cancel_impl (timer_item & timer)
+    {
+        if (in_callback(timer)) {
+            // Callback is in progress, complete() will erase it
+            timer.running = false;
+            timer.cancelled = true;
+        } else {
+            dequeue(timer);
+            erase_timer(timer);
+        }
     }
 
-    /**
-      Destroy the specified timer.
+    // Removes idle timer from the ordering queue, fired one is not there
+    // (its callback is not started yet and will be skipped by run())
+    void dequeue (timer_item & timer)
+    {
+        if (!timer.running)
+            _queue.erase(timer);
+    }
 
-      Synchronizes with the worker thread if the callback for this timer
-      is running, which guarantees that the callback for that callback is
-      not running before clear() returns.
+    void arm_waiter ()
+    {
+        _waiter.arm(_queue.empty() ? (time_point_type::max)() : _queue.next_expiry());
+    }
 
-      You are not required to clear any timers. You can forget their
-      TimerId if you do not need to cancel them.
+    // Makes timer thread recalculate its deadline (or rearms descriptor for
+    // external loop), unlocks @a locker
+    void notify_worker (locker_type & locker)
+    {
+        if (_external) {
+            arm_waiter();
+            locker.unlock();
+        } else {
+            _wakeup_seq.fetch_add(1, std::memory_order_release);
+            locker.unlock();
+            _waiter.notify();
+        }
+    }
 
-      The only time you need this is when you want to stop a timer that
-      has a repetition period, or you want to cancel a timeout that has
-      not fired yet.
-    */
-    bool destroy (timer_id id)
+    // Passes callback of the expired timer to the executor
+    void fire (locker_type & locker, timer_item & timer)
     {
-        locker_type locker(_mtx);
-        auto it = _active.find(id);
-        return destroy_impl(locker, it, true);
+        // Mark it as running to handle racing destroy
+        timer.running = true;
+
+        // Call the callback outside the lock
+        locker.unlock();
+
+        // Timer may be destroyed before executor starts the callback, so it
+        // is looked up by ID
+        auto id = timer.id;
+        _executor.execute([this, id] { run(id); });
+
+        locker.lock();
     }
 
-    /**
-      Destroy all timers, but preserve id uniqueness.
-      This carefully makes sure every timer is not executing its callback
-      before destructing it.
-    */
-    void destroy_all ()
+    // Executes callback of the fired timer (from timer thread or executor's
+    // one)
+    void run (timer_id id)
     {
         locker_type locker(_mtx);
+        auto it = _active.find(id);
+
+        // Destroyed before executor started the callback, it is not
+        // called at all
+        if (it == _active.end())
+            return;
+
+        timer_item & timer = it->second;
+        timer.runner = std::this_thread::get_id();
+        locker.unlock();
 
-        while (!_active.empty())
-            destroy_impl(locker, _active.begin(), _queue.size() == 1);
+        _fired.fetch_add(1, std::memory_order_relaxed);
+        timer.callback();
+        complete(timer);
     }
 
-    std::size_t size () const noexcept
+    // Callback is started and not completed yet
+    bool in_callback (timer_item const & timer) const
     {
-        locker_type locker(_mtx);
-        return _active.size();
+        return timer.runner != std::thread::id{};
     }
 
-    bool empty () const noexcept
+    // Destruction must wait for the callback if it is running by other
+    // thread (callback may destroy timers, including its own, without
+    // waiting for itself)
+    bool must_wait (timer_item const & timer) const
     {
-        locker_type locker(_mtx);
-        return _active.empty();
+        return in_callback(timer) && timer.runner != std::this_thread::get_id();
+    }
+
+    // Spins without holding the lock until deadline, timer creation or
+    // destruction of the pool
+    void spin_until (locker_type & locker, time_point_type deadline)
+    {
+        auto seq = _wakeup_seq.load(std::memory_order_acquire);
+        locker.unlock();
+
+        while (clock_type::now() < deadline && !_done
+                && seq == _wakeup_seq.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        locker.lock();
     }
 
-private:
     void worker ()
     {
         locker_type locker(_mtx);
+        _service_thread = std::this_thread::get_id();
 
         while (!_done) {
+            drain_inbox();
+
             if (_queue.empty()) {
                 // Wait for done or work
-                _wakeup_cv.wait(locker, [this] { return _done || !_queue.empty(); });
+                _waiter.wait(locker);
+                _wakeups.fetch_add(1, std::memory_order_relaxed);
                 continue;
             }
 
-            auto queueHead = _queue.begin();
-            timer_item & timer = *queueHead;
-            auto now = clock_type::now();
+            timer_item * expired = _queue.pop_expired(clock_type::now());
 
-            if (now >= timer.next) {
-                _queue.erase(queueHead);
+            if (expired) {
+                fire(locker, *expired);
+            } else {
+                // Wait until the timer is ready or a timer creation notifies
+                time_point_type next = _queue.next_expiry();
 
-                // Mark it as running to handle racing destroy
-                timer.running = true;
+                if (_spin_threshold.count() > 0 && next - clock_type::now() <= _spin_threshold)
+                    spin_until(locker, next);
+                else
+                    _waiter.wait_until(locker, next - _spin_threshold);
 
-                // Call the callback outside the lock
-                locker.unlock();
-                timer.callback();
-                locker.lock();
+                _wakeups.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
 
-                if (timer.running) {
-                    timer.running = false;
-
-                    // If it is periodic, schedule a new one
-                    if (timer.period.count() > 0) {
-                        timer.next = timer.next + timer.period;
-                        _queue.emplace(timer);
-                    } else {
-                        // Not rescheduling, destruct it
-                        _active.erase(timer.id);
-                    }
-                } else {
-                    // timer.running changed!
-                    //
-                    // Running was set to false, destroy was called
-                    // for this Timer while the callback was in progress
-                    // (this thread was not holding the lock during the callback)
-                    // The thread trying to destroy this timer is waiting on
-                    // a condition variable, so notify it
-                    timer.wait_cv->notify_all();
-
-                    // The clearTimer call expects us to remove the instance
-                    // when it detects that it is racing with its callback
-                    _active.erase(timer.id);
+    // Calculates next tick of the periodic timer according to its missed
+    // tick policy
+    void reschedule (timer_item & timer)
+    {
+        auto now = clock_type::now();
+
+        if (timer.policy == missed_tick_policy::fixed_delay) {
+            timer.due = now + timer.period;
+        } else {
+            timer.due = timer.due + timer.period;
+
+            if (timer.due <= now) {
+                // Ticks not later than now
+                auto behind = static_cast<std::uint64_t>((now - timer.due) / timer.period) + 1;
+                std::uint64_t allowed = timer.policy == missed_tick_policy::skip
+                    ? 0 : timer.max_catch_up;
+
+                if (behind > allowed) {
+                    auto skipped = behind - allowed;
+                    timer.due = timer.due + timer.period * static_cast<duration_type::rep>(skipped);
+                    timer.missed += skipped;
+                    _missed.fetch_add(skipped, std::memory_order_relaxed);
                 }
+            }
+        }
+
+        timer.next = coalesce(timer.due, timer.slack);
+    }
+
+    // Called after callback returned (from timer thread or executor's one)
+    void complete (timer_item & timer)
+    {
+        locker_type locker(_mtx);
+        bool need_notify = false;
+
+        if (timer.running) {
+            timer.running = false;
+            timer.runner = std::thread::id{};
+
+            // If it is periodic, schedule a new one
+            if (timer.period.count() > 0) {
+                reschedule(timer);
+
+                // Timer thread may sleep when callback executed by other
+                // thread
+                need_notify = _queue.empty() || timer.next < _queue.next_expiry();
+                _queue.insert(timer);
             } else {
-                // Wait until the timer is ready or a timer creation notifies
-                time_point_type next = timer.next;
-                _wakeup_cv.wait_until(locker, next);
+                // Not rescheduling, destruct it
+                erase_timer(timer);
+            }
+        } else {
+            // timer.running changed!
+            //
+            // Running was set to false, destroy was called
+            // for this Timer while the callback was in progress
+            // (this thread was not holding the lock during the callback)
+            // The thread trying to destroy this timer is waiting on
+            // a condition variable, so notify it
+            //
+            // Completions of cancel_async() are called first, so destroy
+            // returns after them (timer stays flagged as cancelled, so
+            // cancel_async() may add more of them meanwhile)
+            while (timer.on_cancelled) {
+                auto completion = std::move(timer.on_cancelled);
+                timer.on_cancelled = nullptr;
+                locker.unlock();
+                completion();
+                locker.lock();
             }
+
+            timer.runner = std::thread::id{};
+
+            if (timer.wait_cv)
+                timer.wait_cv->notify_all();
+
+            // The clearTimer call expects us to remove the instance
+            // when it detects that it is racing with its callback
+            erase_timer(timer);
         }
+
+        if (need_notify)
+            notify_worker(locker);
     }
 
     bool destroy_impl (locker_type & locker, typename timer_map::iterator it, bool notify)
@@ -320,25 +2153,26 @@ private:
 
         timer_item & timer = it->second;
 
-        if (timer.running) {
+        if (in_callback(timer)) {
             // A callback is in progress for this Timer,
             // so flag it for deletion in the worker
             timer.running = false;
+            timer.cancelled = true;
 
-            // Assign a condition variable to this timer
-            timer.wait_cv.reset(new condition_variable_type);
+            // Assign a condition variable to this timer (shared by all
+            // destroying threads)
+            if (!timer.wait_cv)
+                timer.wait_cv.reset(new condition_variable_type);
 
             // Block until the callback is finished
-            if (std::this_thread::get_id() != _worker.get_id())
+            if (must_wait(timer))
                 timer.wait_cv->wait(locker);
         } else {
-            _queue.erase(timer);
-            _active.erase(it);
+            dequeue(timer);
+            erase_timer(timer);
 
-            if (notify) {
-                locker.unlock();
-                _wakeup_cv.notify_all();
-            }
+            if (notify)
+                notify_worker(locker);
         }
 
         return true;
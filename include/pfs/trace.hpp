@@ -0,0 +1,480 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-modulus](https://github.com/semenovf/pfs-modulus) library.
+//
+// Changelog:
+//      2026.10.18 Initial version (Chrome trace-event recorder).
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cassert>
+
+namespace pfs {
+
+namespace trace_details {
+
+enum class phase : char
+{
+      complete   = 'X' // Span with duration
+    , flow_start = 's'
+    , flow_end   = 'f'
+};
+
+// Interned label identifiers, 0 means no label
+struct label
+{
+    std::uint32_t name {0};
+    std::uint32_t module {0};
+    int api_id {-1};
+};
+
+struct event
+{
+    phase ph;
+    char const * category; // Static string
+    label lbl;
+    std::int64_t ts_ns;
+    std::int64_t dur_ns;
+    std::uint64_t flow_id;
+    std::int64_t wait_ns;  // Time spent in the queue, -1 if not queued
+};
+
+// Events of one thread. Written by owning thread only, read by dumper
+// up to published size, so no locking is required while recording.
+class thread_buffer
+{
+public:
+    std::uint32_t tid;
+    std::string name; // Guarded by tracer mutex
+    std::unique_ptr<event[]> events;
+    std::size_t capacity;
+    std::atomic<std::size_t> size {0};
+    std::atomic<std::uint64_t> dropped {0};
+    bool retired {false}; // Owning thread exited, guarded by tracer mutex
+
+public:
+    thread_buffer (std::uint32_t id, std::size_t cap)
+        : tid(id)
+        , events(new event[cap])
+        , capacity(cap)
+    {}
+
+    void push (event const & e) noexcept
+    {
+        auto n = size.load(std::memory_order_relaxed);
+
+        if (n >= capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        events[n] = e;
+        size.store(n + 1, std::memory_order_release);
+    }
+};
+
+inline void append_escaped (std::string & out, std::string const & s)
+{
+    for (char c: s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+}
+
+inline void append_us (std::string & out, std::int64_t ns)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.3f", static_cast<double>(ns) / 1000.0);
+    out += buf;
+}
+
+} // namespace trace_details
+
+/**
+ * Process wide recorder of trace events in Chrome trace-event format
+ * (can be opened in Perfetto UI or chrome://tracing).
+ *
+ * Each thread records into its own fixed size buffer (allocated on first
+ * event), events not fitting into buffer are counted as dropped. Labels
+ * (span names, module names) are interned once, so recording is
+ * allocation and lock free. Buffer of exited thread is kept until its
+ * events are discarded by clear(), then it is reused by new thread.
+ *
+ * Recording is switched on by start() and off by stop(), buffers must not
+ * be cleared while recording.
+ */
+class tracer
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using event_type = trace_details::event;
+    using label_type = trace_details::label;
+
+private:
+    mutable std::mutex _mtx;
+    clock_type::time_point _epoch {clock_type::now()};
+    std::atomic<bool> _active {false};
+    std::atomic<std::size_t> _capacity {65536};
+    std::atomic<std::uint64_t> _flow_id {0};
+    std::vector<std::string> _labels {std::string{}};
+    std::unordered_map<std::string, std::uint32_t> _label_ids;
+    std::vector<std::unique_ptr<trace_details::thread_buffer>> _buffers;
+
+    tracer () = default;
+
+public:
+    tracer (tracer const &) = delete;
+    tracer & operator = (tracer const &) = delete;
+
+    static tracer & instance ()
+    {
+        static tracer t;
+        return t;
+    }
+
+    /**
+     * Starts recording. @a events_per_thread is the capacity of buffers
+     * allocated after this call.
+     */
+    void start (std::size_t events_per_thread = 65536)
+    {
+        assert(events_per_thread > 0);
+        _capacity.store(events_per_thread, std::memory_order_relaxed);
+        _active.store(true, std::memory_order_release);
+    }
+
+    void stop ()
+    {
+        _active.store(false, std::memory_order_release);
+    }
+
+    bool is_active () const noexcept
+    {
+        return _active.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Discards recorded events. Must be called when recording is stopped.
+     * Buffers of exited threads become free for reuse.
+     */
+    void clear ()
+    {
+        assert(!is_active());
+        std::lock_guard<std::mutex> lock(_mtx);
+
+        for (auto & b: _buffers) {
+            b->size.store(0, std::memory_order_relaxed);
+            b->dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @return Number of allocated thread buffers.
+     */
+    std::size_t buffer_count () const
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        return _buffers.size();
+    }
+
+    std::int64_t now () const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock_type::now() - _epoch).count();
+    }
+
+    std::uint32_t intern (std::string const & s)
+    {
+        if (s.empty())
+            return 0;
+
+        std::lock_guard<std::mutex> lock(_mtx);
+        auto it = _label_ids.find(s);
+
+        if (it != _label_ids.end())
+            return it->second;
+
+        auto id = static_cast<std::uint32_t>(_labels.size());
+        _labels.push_back(s);
+        _label_ids.emplace(s, id);
+        return id;
+    }
+
+    label_type make_label (std::string const & name
+        , std::string const & module = std::string{}
+        , int api_id = -1)
+    {
+        label_type result;
+        result.name = intern(name);
+        result.module = intern(module);
+        result.api_id = api_id;
+        return result;
+    }
+
+    std::uint64_t next_flow_id () noexcept
+    {
+        return _flow_id.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    /**
+     * Sets name of the calling thread displayed by viewer.
+     */
+    void set_thread_name (std::string const & name)
+    {
+        thread_name() = name;
+        auto buf = local_buffer();
+
+        if (buf) {
+            std::lock_guard<std::mutex> lock(_mtx);
+            buf->name = name;
+        }
+    }
+
+    void record (event_type const & e)
+    {
+        if (!is_active())
+            return;
+
+        auto buf = local_buffer();
+
+        if (!buf)
+            buf = register_buffer();
+
+        buf->push(e);
+    }
+
+    void record_span (char const * category, label_type const & lbl
+        , std::int64_t start_ns, std::int64_t end_ns, std::int64_t wait_ns = -1)
+    {
+        record(event_type{trace_details::phase::complete, category, lbl
+            , start_ns, end_ns - start_ns, 0, wait_ns});
+    }
+
+    void record_flow (trace_details::phase ph, std::uint64_t id, std::int64_t ts_ns)
+    {
+        record(event_type{ph, "flow", label_type{}, ts_ns, 0, id, -1});
+    }
+
+    std::uint64_t dropped () const
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        std::uint64_t result = 0;
+
+        for (auto const & b: _buffers)
+            result += b->dropped.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    std::size_t size () const
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        std::size_t result = 0;
+
+        for (auto const & b: _buffers)
+            result += b->size.load(std::memory_order_acquire);
+
+        return result;
+    }
+
+    /**
+     * Returns recorded events in Chrome trace-event JSON format.
+     */
+    std::string chrome_json () const
+    {
+        using trace_details::append_escaped;
+        using trace_details::append_us;
+
+        std::lock_guard<std::mutex> lock(_mtx);
+        std::string out {"{\"traceEvents\":["};
+        bool first = true;
+
+        auto begin_event = [& out, & first] () {
+            out += first ? "\n" : ",\n";
+            first = false;
+        };
+
+        for (auto const & b: _buffers) {
+            auto tid = std::to_string(b->tid);
+
+            if (!b->name.empty()) {
+                begin_event();
+                out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+                out += tid;
+                out += ",\"args\":{\"name\":\"";
+                append_escaped(out, b->name);
+                out += "\"}}";
+            }
+
+            auto n = b->size.load(std::memory_order_acquire);
+
+            for (std::size_t i = 0; i < n; i++) {
+                auto const & e = b->events[i];
+
+                begin_event();
+                out += "{\"name\":\"";
+
+                if (e.ph == trace_details::phase::complete)
+                    append_escaped(out, _labels[e.lbl.name]);
+                else
+                    out += "flow";
+
+                out += "\",\"cat\":\"";
+                out += e.category;
+                out += "\",\"ph\":\"";
+                out += static_cast<char>(e.ph);
+                out += "\",\"pid\":1,\"tid\":";
+                out += tid;
+                out += ",\"ts\":";
+                append_us(out, e.ts_ns);
+
+                if (e.ph == trace_details::phase::complete) {
+                    out += ",\"dur\":";
+                    append_us(out, e.dur_ns);
+                    out += ",\"args\":{";
+
+                    bool first_arg = true;
+
+                    if (e.lbl.module != 0) {
+                        out += "\"module\":\"";
+                        append_escaped(out, _labels[e.lbl.module]);
+                        out += "\"";
+                        first_arg = false;
+                    }
+
+                    if (e.lbl.api_id >= 0) {
+                        out += first_arg ? "" : ",";
+                        out += "\"api_id\":";
+                        out += std::to_string(e.lbl.api_id);
+                        first_arg = false;
+                    }
+
+                    if (e.wait_ns >= 0) {
+                        out += first_arg ? "" : ",";
+                        out += "\"queue_wait_us\":";
+                        append_us(out, e.wait_ns);
+                    }
+
+                    out += "}";
+                } else {
+                    out += ",\"id\":";
+                    out += std::to_string(e.flow_id);
+
+                    // Bind flow end to the enclosing slice
+                    if (e.ph == trace_details::phase::flow_end)
+                        out += ",\"bp\":\"e\"";
+                }
+
+                out += "}";
+            }
+        }
+
+        out += "\n],\"displayTimeUnit\":\"ns\"}\n";
+        return out;
+    }
+
+    /**
+     * Writes recorded events into file @a path.
+     */
+    bool dump (std::string const & path) const
+    {
+        auto text = chrome_json();
+        auto f = std::fopen(path.c_str(), "wb");
+
+        if (!f)
+            return false;
+
+        auto ok = std::fwrite(text.data(), 1, text.size(), f) == text.size();
+        return std::fclose(f) == 0 && ok;
+    }
+
+private:
+    static std::string & thread_name ()
+    {
+        static thread_local std::string name;
+        return name;
+    }
+
+    // Marks buffer of the thread as retired on thread exit
+    struct buffer_owner
+    {
+        trace_details::thread_buffer * buf {nullptr};
+
+        ~buffer_owner ()
+        {
+            if (buf)
+                tracer::instance().retire(buf);
+        }
+    };
+
+    static trace_details::thread_buffer *& local_buffer_ref ()
+    {
+        static thread_local buffer_owner owner;
+        return owner.buf;
+    }
+
+    trace_details::thread_buffer * local_buffer () const
+    {
+        return local_buffer_ref();
+    }
+
+    void retire (trace_details::thread_buffer * buf)
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        buf->retired = true;
+    }
+
+    // Buffers are owned by tracer and outlive their threads, so events of
+    // finished threads remain available for dump. Retired buffer is reused
+    // once its events are discarded by clear().
+    trace_details::thread_buffer * register_buffer ()
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        auto capacity = _capacity.load(std::memory_order_relaxed);
+        trace_details::thread_buffer * buf = nullptr;
+
+        for (auto & b: _buffers) {
+            if (b->retired && b->size.load(std::memory_order_relaxed) == 0
+                    && b->dropped.load(std::memory_order_relaxed) == 0) {
+                buf = b.get();
+                break;
+            }
+        }
+
+        if (buf) {
+            if (buf->capacity != capacity) {
+                buf->events.reset(new trace_details::event[capacity]);
+                buf->capacity = capacity;
+            }
+
+            buf->retired = false;
+        } else {
+            auto tid = static_cast<std::uint32_t>(_buffers.size() + 1);
+            _buffers.emplace_back(new trace_details::thread_buffer(tid, capacity));
+            buf = _buffers.back().get();
+        }
+
+        buf->name = thread_name();
+        local_buffer_ref() = buf;
+        return buf;
+    }
+};
+
+} // namespace pfs
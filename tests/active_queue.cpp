@@ -11,6 +11,7 @@
 #include "pfs/active_queue.hpp"
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <limits>
 #include <thread>
 
@@ -42,6 +43,9 @@ TEST_CASE("Active Queue: using regular function") {
 
     CHECK(max_count > 0);
     CHECK(t0::counter == max_count);
+    CHECK(q.processed_count() == static_cast<std::uint64_t>(max_count));
+    CHECK(q.dropped_count() == 0);
+    CHECK(q.busy_time().count() > 0);
 
     max_count = 100;
 
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-modulus](https://github.com/semenovf/pfs-modulus) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/metrics.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#if _POSIX_C_SOURCE
+#   include <sys/socket.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+#endif
+
+using metrics_registry = pfs::metrics_registry<>;
+
+TEST_CASE("Metrics registry") {
+    metrics_registry registry;
+    std::atomic<std::uint64_t> processed_a {0};
+    std::atomic<std::uint64_t> processed_b {0};
+    int owner_a = 0;
+    int owner_b = 0;
+
+    registry.add("events_total", pfs::metric_type::counter, "Events processed"
+        , {{"module", "a"}}
+        , [& processed_a] { return static_cast<double>(processed_a.load()); }
+        , & owner_a);
+    registry.add("queue_depth", pfs::metric_type::gauge, ""
+        , {{"module", "a\"b\\c"}}, [] { return 1.5; }, & owner_a);
+    registry.add("events_total", pfs::metric_type::counter, "Events processed"
+        , {{"module", "b"}}
+        , [& processed_b] { return static_cast<double>(processed_b.load()); }
+        , & owner_b);
+
+    processed_a = 3;
+    processed_b = 7;
+
+    auto samples = registry.snapshot();
+    REQUIRE(samples.size() == 3);
+
+    // Samples of the same metric are adjacent
+    CHECK(samples[0].name == "events_total");
+    CHECK(samples[0].value == 3);
+    CHECK(samples[1].name == "events_total");
+    CHECK(samples[1].value == 7);
+    CHECK(samples[2].name == "queue_depth");
+
+    CHECK(registry.prometheus_text() ==
+        "# HELP events_total Events processed\n"
+        "# TYPE events_total counter\n"
+        "events_total{module=\"a\"} 3\n"
+        "events_total{module=\"b\"} 7\n"
+        "# TYPE queue_depth gauge\n"
+        "queue_depth{module=\"a\\\"b\\\\c\"} 1.5\n");
+
+    CHECK(registry.remove(& owner_a) == 2);
+    CHECK(registry.size() == 1);
+    CHECK(registry.prometheus_text().find("module=\"a\"") == std::string::npos);
+}
+
+TEST_CASE("Thread CPU meter") {
+    pfs::thread_cpu_meter meter;
+
+    std::thread th([& meter] {
+        pfs::thread_cpu_meter::scope scope(meter);
+        auto start = std::chrono::steady_clock::now();
+
+        // Busy loop
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(20))
+            ;
+    });
+
+    th.join();
+
+    auto seconds = meter.seconds();
+
+#if _POSIX_C_SOURCE
+    CHECK(seconds > 0.005);
+#endif
+
+    // Value is kept after the thread finished
+    CHECK(meter.seconds() == seconds);
+}
+
+TEST_CASE("Metrics exporter") {
+    metrics_registry registry;
+    registry.add("up", pfs::metric_type::gauge, "", {}, [] { return 1.0; });
+
+    pfs::metrics_exporter<metrics_registry> exporter(registry);
+
+    std::string path = "/tmp/pfs_modulus_metrics_test.prom";
+    std::remove(path.c_str());
+
+    CHECK(exporter.start_file(path, 0.01));
+    CHECK_FALSE(exporter.start_file(path, 0.01));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    exporter.stop();
+
+    auto f = std::fopen(path.c_str(), "r");
+    REQUIRE(f);
+    char buf[64] = {0};
+    auto n = std::fread(buf, 1, sizeof(buf) - 1, f);
+    std::fclose(f);
+    std::remove(path.c_str());
+
+    CHECK(std::string(buf, n) == "# TYPE up gauge\nup 1\n");
+
+#if _POSIX_C_SOURCE
+    std::string socket_path = "/tmp/pfs_modulus_metrics_test.sock";
+    REQUIRE(exporter.start_unix_socket(socket_path));
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    REQUIRE(fd >= 0);
+
+    struct sockaddr_un addr;
+    std::memset(& addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size());
+
+    REQUIRE(::connect(fd, reinterpret_cast<struct sockaddr *>(& addr), sizeof(addr)) == 0);
+
+    std::string request = "GET /metrics HTTP/1.0\r\n\r\n";
+    CHECK(::write(fd, request.data(), request.size()) == static_cast<ssize_t>(request.size()));
+
+    std::string response;
+    char rbuf[256];
+    ssize_t rn = 0;
+
+    while ((rn = ::read(fd, rbuf, sizeof(rbuf))) > 0)
+        response.append(rbuf, static_cast<std::size_t>(rn));
+
+    ::close(fd);
+    exporter.stop();
+
+    CHECK(response.find("HTTP/1.0 200 OK\r\n") == 0);
+    CHECK(response.find("\r\n\r\n# TYPE up gauge\nup 1\n") != std::string::npos);
+    CHECK(::access(socket_path.c_str(), F_OK) != 0);
+#endif
+}
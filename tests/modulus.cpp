@@ -9,9 +9,16 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 #include "pfs/modulus.hpp"
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <functional>
 #include <limits>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 using modulus = pfs::modulus<>;
 
@@ -62,6 +69,19 @@ public:
 
         emitData(std::move(d));
 
+        emitDebounced.set_timer_service(timer_service());
+
+        for (int i = 0; i < 10; i++)
+            emitDebounced(int{i});
+
+        CHECK(emitDebounced.suppressed_count() == 9);
+
+        // Timer not fired yet is cancelled immediately
+        bool cancelled = false;
+        auto id = acquire_timer(3600, 0, [] {});
+        cancel_timer(id, [& cancelled] { cancelled = true; });
+        CHECK(cancelled);
+
         return true;
     }
 
@@ -90,11 +110,14 @@ public: /*signal*/
     modulus::sigslot_ns::signal<bool, char, short, int, long> emitFiveArgs;
     modulus::sigslot_ns::signal<bool, char, short, int, long, std::string> emitSixArgs;
     modulus::sigslot_ns::signal<Data> emitData;
+    modulus::debounced_signal<int> emitDebounced {0.01};
 };
 
 class detector_module : public modulus::module
 {
     int _counter = 0;
+    int _accepted_counter = 0;
+    int _rejected_counter = 0;
 
 public:
     detector_module () : modulus::module()
@@ -110,6 +133,8 @@ public:
 
     virtual bool on_finish () override
     {
+        CHECK(_accepted_counter == 2);
+        CHECK(_rejected_counter == 0);
         return true;
     }
 
@@ -122,9 +147,31 @@ public:
         , MODULUS_DETECTOR(5, detector_module::onFiveArgs)
         , MODULUS_DETECTOR(6, detector_module::onSixArgs)
         , MODULUS_DETECTOR(7, detector_module::onData)
+        , MODULUS_FILTERED_DETECTOR(2, detector_module::onTwoArgsAccepted, detector_module::acceptC)
+        , MODULUS_FILTERED_DETECTOR(2, detector_module::onTwoArgsRejected, detector_module::acceptX)
     MODULUS_END_DETECTORS
 
 private:
+    bool acceptC (bool const &, char const & ch) const
+    {
+        return ch == 'c';
+    }
+
+    bool acceptX (bool const &, char const & ch) const
+    {
+        return ch == 'x';
+    }
+
+    void onTwoArgsAccepted (bool, char)
+    {
+        _accepted_counter++;
+    }
+
+    void onTwoArgsRejected (bool, char)
+    {
+        _rejected_counter++;
+    }
+
     void onZeroArg ()
     {
         _counter++;
@@ -187,12 +234,33 @@ public:
 
     int run ()
     {
+        // Ticks are queued to the module
+        int ticks = 0;
+        auto id = acquire_timer(0.005, 0.005, [& ticks] { ++ticks; });
+        acquire_timer(3600, 0, [] {});
+        CHECK(timer_count() == 2);
+
         int i = 3;
         while (! is_quit() && i--) {
             std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            flush_all_batches();
             call_all();
         }
 
+        // Ticks left in the queue outlive destroyed timer
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        destroy_timer(id);
+        call_all();
+        CHECK(ticks > 0);
+        CHECK(timer_count() == 1);
+
+        auto text = get_dispatcher()->metrics().prometheus_text();
+        CHECK(text.find("# TYPE modulus_events_processed_total counter") != std::string::npos);
+        CHECK(text.find("modulus_queue_depth{module=\"async_module\"}") != std::string::npos);
+        CHECK(text.find("modulus_thread_cpu_seconds_total{module=\"dispatcher\"}") != std::string::npos);
+        CHECK(text.find("modulus_timer_fires_total{module=\"slave_module\"}") != std::string::npos);
+        CHECK(text.find("modulus_timers{module=\"async_module\"} 1") != std::string::npos);
+
         quit();
 
         return 0;
@@ -232,6 +300,7 @@ public:
           MODULUS_DETECTOR(1, slave_module::onOneArg)
         , MODULUS_DETECTOR(2, slave_module::onTwoArgs)
         , MODULUS_DETECTOR(7, slave_module::onData)
+        , MODULUS_BATCH_DETECTOR(1, slave_module::onOneArgBatch, 16, 0)
     MODULUS_END_DETECTORS
 
 public: /*signal*/
@@ -251,6 +320,14 @@ public: /*slots*/
         CHECK_MESSAGE(ch == 'c', "from slave_module: onTwoArgs(true, 'c')");
     }
 
+    void onOneArgBatch (modulus::sigslot_ns::batch_span<bool> batch)
+    {
+        CHECK(batch.size() > 0);
+
+        for (auto const & args: batch)
+            CHECK_MESSAGE(std::get<0>(args), "from slave_module: onOneArgBatch()");
+    }
+
     void onData (Data const & d)
     {
         _counter++;
@@ -284,6 +361,418 @@ TEST_CASE("Modulus basics") {
     CHECK_FALSE(dispatcher.register_module_for_name(std::make_pair("module-for-test-app-nonexistence", "")));
 
     CHECK(dispatcher.count() == 4);
+    // Queue, thread and timer metrics for dispatcher and async_module,
+    // timer metrics for other modules
+    CHECK(dispatcher.metrics().size() == 2 * 7 + 3 * 2);
+
+    CHECK(dispatcher.exec() == 0);
+
+    // Metrics are removed before timer pool is destroyed
+    CHECK(dispatcher.metrics().size() == 0);
+
+    // Profiling is compiled out by default
+    CHECK(dispatcher.profile_snapshot().empty());
+}
+
+namespace profiling {
+
+// Emission profiling enabled
+using modulus = pfs::modulus<true
+    , std::string
+    , pfs::simple_logger
+    , pfs::default_settings
+    , pfs::default_timer_pool
+    , std::function<void ()>
+    , pfs::default_associative_container
+    , pfs::default_sequence_container
+    , pfs::default_queue_container
+    , pfs::default_basic_lockable
+    , pfs::profiling_policy>;
+
+class emitter_module : public modulus::module
+{
+public:
+    bool on_start (modulus::settings_type const &) override
+    {
+        emitTwoArgs(true, 'c');
+        return true;
+    }
+
+    MODULUS_BEGIN_INLINE_EMITTERS
+          MODULUS_EMITTER(2, emitTwoArgs)
+    MODULUS_END_EMITTERS
+
+public: /*signal*/
+    modulus::sigslot_ns::signal<bool, char> emitTwoArgs;
+};
+
+class detector_module : public modulus::module
+{
+public:
+    MODULUS_BEGIN_INLINE_DETECTORS
+          MODULUS_DETECTOR(2, detector_module::onTwoArgs)
+        , MODULUS_FILTERED_DETECTOR(2, detector_module::onTwoArgsAccepted, detector_module::acceptC)
+        , MODULUS_FILTERED_DETECTOR(2, detector_module::onTwoArgsRejected, detector_module::acceptX)
+    MODULUS_END_DETECTORS
+
+private:
+    bool acceptC (bool const &, char const & ch) const
+    {
+        return ch == 'c';
+    }
+
+    bool acceptX (bool const &, char const & ch) const
+    {
+        return ch == 'x';
+    }
+
+    void onTwoArgs (bool, char) {}
+    void onTwoArgsAccepted (bool, char) {}
+    void onTwoArgsRejected (bool, char) {}
+};
+
+class async_module : public modulus::async_module
+{
+public:
+    int run () override
+    {
+        call_all();
+        quit();
+        return 0;
+    }
+};
+
+static modulus::api_item_type API[] = {
+    { 2 , modulus::make_mapper<bool, char>(), "TwoArgs(bool b, char ch)" }
+};
+
+} // namespace profiling
+
+TEST_CASE("Emission profiling") {
+    pfs::default_settings settings;
+    pfs::simple_logger logger;
+    profiling::modulus::dispatcher dispatcher(profiling::API
+        , sizeof(profiling::API) / sizeof(profiling::API[0]), settings, logger);
+
+    CHECK(dispatcher.register_module<profiling::emitter_module>(std::make_pair("emitter_module", "")));
+    CHECK(dispatcher.register_module<profiling::detector_module>(std::make_pair("detector_module", "")));
+    CHECK(dispatcher.register_module<profiling::async_module>(std::make_pair("async_module", "")));
+
+    auto & tracer = pfs::tracer::instance();
+    tracer.clear();
+    tracer.start();
+
     CHECK(dispatcher.exec() == 0);
+
+    tracer.stop();
+
+    // Spans are labeled by API identifier, threads by module name
+    auto trace = tracer.chrome_json();
+    CHECK(trace.find("\"name\":\"emit:2\"") != std::string::npos);
+    CHECK(trace.find("\"name\":\"detect:2\"") != std::string::npos);
+    CHECK(trace.find("\"module\":\"detector_module\"") != std::string::npos);
+    CHECK(trace.find("{\"name\":\"dispatcher\"}") != std::string::npos);
+    CHECK(trace.find("{\"name\":\"async_module\"}") != std::string::npos);
+
+    auto profile = dispatcher.profile_snapshot();
+    CHECK(!profile.empty());
+
+    // TwoArgs has plain and two filtered detectors in detector_module
+    int two_args_records = 0;
+    std::uint64_t two_args_deliveries = 0;
+
+    for (auto const & rec: profile) {
+        CHECK(rec.delivery.deliveries <= rec.emissions);
+        CHECK(rec.delivery.total_ns >= rec.delivery.max_ns);
+
+        if (rec.api_id == 2 && rec.emitter == "emitter_module"
+                && rec.detector == "detector_module") {
+            two_args_records++;
+            two_args_deliveries += rec.delivery.deliveries;
+            CHECK(rec.emissions > 0);
+        }
+    }
+
+    CHECK(two_args_records == 3);
+    CHECK(two_args_deliveries > 0);
 }
 
+
+namespace watchdog {
+
+class emitter_module : public modulus::module
+{
+public:
+    bool on_start (modulus::settings_type const &) override
+    {
+        emitOneArg(true);
+        emitOneArg(false);
+        return true;
+    }
+
+    MODULUS_BEGIN_INLINE_EMITTERS
+          MODULUS_EMITTER(1, emitOneArg)
+    MODULUS_END_EMITTERS
+
+public: /*signal*/
+    modulus::sigslot_ns::signal<bool> emitOneArg;
+};
+
+class stalling_module : public modulus::async_module
+{
+public:
+    int run () override
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        while (!is_quit() && std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            call_all();
+        }
+
+        quit();
+        return 0;
+    }
+
+    MODULUS_BEGIN_INLINE_DETECTORS
+          MODULUS_DETECTOR(1, stalling_module::onOneArg)
+    MODULUS_END_DETECTORS
+
+public: /*slots*/
+    void onOneArg (bool)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+};
+
+class stall_collector : public modulus::sigslot_ns::slot_holder
+{
+    std::mutex _mtx;
+
+public:
+    std::vector<modulus::dispatcher::stall_report> reports;
+
+    void onStalled (modulus::dispatcher::stall_report const & report)
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        reports.push_back(report);
+    }
+};
+
+static modulus::api_item_type API[] = {
+    { 1 , modulus::make_mapper<bool>(), "OneArg(bool b)" }
+};
+
+} // namespace watchdog
+
+TEST_CASE("Watchdog") {
+    pfs::default_settings settings;
+    pfs::simple_logger logger;
+    modulus::dispatcher dispatcher(watchdog::API
+        , sizeof(watchdog::API) / sizeof(watchdog::API[0]), settings, logger);
+
+    watchdog::stall_collector collector;
+    dispatcher.module_stalled.connect(& collector, & watchdog::stall_collector::onStalled);
+    dispatcher.set_watchdog(0.1, 0.1);
+
+    // Frozen signals are unfrozen after module threads are joined
+    dispatcher.set_frozen_topology(true);
+
+    CHECK(dispatcher.register_module<watchdog::emitter_module>(std::make_pair("emitter_module", "")));
+    CHECK(dispatcher.register_module<watchdog::stalling_module>(std::make_pair("stalling_module", "")));
+    CHECK(dispatcher.exec() == 0);
+
+    bool queue_stalled = false;
+    bool handler_overrun = false;
+
+    for (auto const & r: collector.reports) {
+        CHECK(r.module == "stalling_module");
+
+        if (r.kind == modulus::dispatcher::stall_report::queue_stalled) {
+            queue_stalled = true;
+            CHECK(r.queue_depth == 1);
+        }
+
+        if (r.kind == modulus::dispatcher::stall_report::handler_overrun) {
+            handler_overrun = true;
+            CHECK(r.duration >= 0.1);
+            CHECK(r.api_id == 1);
+            CHECK(r.detector == "stalling_module");
+        }
+    }
+
+    CHECK(queue_stalled);
+    CHECK(handler_overrun);
+}
+
+namespace batching {
+
+// Accessed by dispatcher's thread while exec() runs
+static int delivered = 0;
+static int batches = 0;
+
+class emitter_module : public modulus::module
+{
+public:
+    bool on_start (modulus::settings_type const &) override
+    {
+        emitOneArg(true);
+        emitOneArg(true);
+        emitOneArg(true);
+        return true;
+    }
+
+    MODULUS_BEGIN_INLINE_EMITTERS
+          MODULUS_EMITTER(1, emitOneArg)
+    MODULUS_END_EMITTERS
+
+public: /*signal*/
+    modulus::sigslot_ns::signal<bool> emitOneArg;
+};
+
+// Slave of the dispatcher, batch is never filled up, so events are
+// delivered when linger time expired
+class collector_module : public modulus::slave_module
+{
+public:
+    bool on_start (modulus::settings_type const &) override
+    {
+        // Quits if batch is never delivered
+        acquire_timer(5, 0, [this] { quit(); });
+        return true;
+    }
+
+    MODULUS_BEGIN_INLINE_DETECTORS
+          MODULUS_BATCH_DETECTOR(1, collector_module::onOneArgBatch, 16, 0.02)
+    MODULUS_END_DETECTORS
+
+public: /*slots*/
+    void onOneArgBatch (modulus::sigslot_ns::batch_span<bool> batch)
+    {
+        batches++;
+        delivered += static_cast<int>(batch.size());
+
+        if (delivered == 3)
+            quit();
+    }
+};
+
+static modulus::api_item_type API[] = {
+    { 1 , modulus::make_mapper<bool>(), "OneArg(bool b)" }
+};
+
+} // namespace batching
+
+TEST_CASE("Batch detector linger") {
+    pfs::default_settings settings;
+    pfs::simple_logger logger;
+    modulus::dispatcher dispatcher(batching::API
+        , sizeof(batching::API) / sizeof(batching::API[0]), settings, logger);
+
+    CHECK(dispatcher.register_module<batching::emitter_module>(std::make_pair("emitter_module", "")));
+    CHECK(dispatcher.register_module<batching::collector_module>(std::make_pair("collector_module", "")));
+
+    auto start = std::chrono::steady_clock::now();
+    CHECK(dispatcher.exec() == 0);
+
+    CHECK(batching::delivered == 3);
+    CHECK(batching::batches == 1);
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+}
+
+namespace timer_ticks {
+
+// Queued callbacks which std::function could not store inline (allocated)
+static std::atomic<int> heap_stored {0};
+
+// Queue item counting allocations of std::function
+class counting_function
+{
+    std::function<void ()> _f;
+
+public:
+    counting_function () = default;
+
+    template <typename F, typename = typename std::enable_if<
+        !std::is_same<typename std::decay<F>::type, counting_function>::value>::type>
+    counting_function (F && f) : _f(std::forward<F>(f))
+    {
+        using target_type = typename std::decay<F>::type;
+        auto target = reinterpret_cast<char const *>(_f.template target<target_type>());
+        auto self = reinterpret_cast<char const *>(& _f);
+
+        if (target < self || target >= self + sizeof(_f))
+            ++heap_stored;
+    }
+
+    void operator () () const
+    {
+        _f();
+    }
+};
+
+using modulus = pfs::modulus<true
+    , std::string
+    , pfs::simple_logger
+    , pfs::default_settings
+    , pfs::default_timer_pool
+    , counting_function>;
+
+// Accessed by module's thread while exec() runs
+static int ticks = 0;
+static int allocations = -1;
+
+class ticking_module : public modulus::async_module
+{
+public:
+    int run () override
+    {
+        acquire_timer(0.001, 0.001, [] { ++ticks; });
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        auto wait_ticks = [deadline, this] (int n) {
+            while (ticks < n && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                call_all();
+            }
+        };
+
+        // Warm up
+        wait_ticks(5);
+
+        auto before = heap_stored.load();
+        wait_ticks(55);
+        allocations = heap_stored.load() - before;
+
+        quit();
+        return 0;
+    }
+};
+
+static modulus::api_item_type API[] = {
+    { 1 , modulus::make_mapper<bool>(), "OneArg(bool b)" }
+};
+
+} // namespace timer_ticks
+
+TEST_CASE("Timer ticks do not allocate") {
+    using timer_ticks::counting_function;
+
+    // Large callable is allocated by std::function, so it is counted
+    char large[64] = {};
+    auto before = timer_ticks::heap_stored.load();
+    counting_function f {[large] { (void)large; }};
+    CHECK(timer_ticks::heap_stored == before + 1);
+
+    pfs::default_settings settings;
+    pfs::simple_logger logger;
+    timer_ticks::modulus::dispatcher dispatcher(timer_ticks::API
+        , sizeof(timer_ticks::API) / sizeof(timer_ticks::API[0]), settings, logger);
+
+    CHECK(dispatcher.register_module<timer_ticks::ticking_module>(std::make_pair("ticking_module", "")));
+    CHECK(dispatcher.exec() == 0);
+
+    // Periodic ticks are queued to the module without allocation
+    CHECK(timer_ticks::ticks >= 55);
+    CHECK(timer_ticks::allocations == 0);
+}
@@ -7,9 +7,20 @@
 //      2019.12.19 Initial version (inherited from https://github.com/semenovf/pfs)
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define ANKERL_NANOBENCH_IMPLEMENT
 #include "doctest.h"
+#include "nanobench.h"
 #include "pfs/active_queue.hpp"
 #include "pfs/sigslot.hpp"
+#include "pfs/timer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Direct signals / slots
@@ -127,3 +138,861 @@ TEST_CASE("Queued signals / slots") {
 
     CHECK(b.counter == 8);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// RCU signals / slots
+////////////////////////////////////////////////////////////////////////////////
+namespace t2 {
+
+using sigslot = pfs::sigslot<>;
+
+class C : public sigslot::slot_holder
+{
+public:
+    std::atomic_int counter {0};
+
+public:
+    void slot (int) { counter++; }
+};
+
+} // namespace t2
+
+TEST_CASE("RCU signals / slots") {
+    using t2::C;
+    using t2::sigslot;
+
+    sigslot::rcu_signal<int> sig;
+    C c1;
+
+    CHECK_FALSE(sig.is_connected());
+
+    sig.connect(& c1, & C::slot);
+    CHECK(sig.is_connected());
+
+    sig(42);
+    CHECK(c1.counter == 1);
+
+    std::atomic_bool done {false};
+    std::vector<std::thread> emitters;
+
+    for (int i = 0; i < 4; i++) {
+        emitters.emplace_back([& sig, & done] {
+            while (!done)
+                sig(42);
+        });
+    }
+
+    // Connect/disconnect concurrently with emission
+    for (int i = 0; i < 100; i++) {
+        C c2;
+        sig.connect(& c2, & C::slot);
+        std::this_thread::yield();
+        sig.disconnect(& c2);
+    }
+
+    done = true;
+
+    for (auto & t: emitters)
+        t.join();
+
+    CHECK(c1.counter > 1);
+    CHECK(c1.count() == 1);
+
+    int counter = c1.counter;
+    sig.disconnect(& c1);
+    sig(42);
+
+    CHECK(c1.counter == counter);
+    CHECK(c1.count() == 0);
+    CHECK_FALSE(sig.is_connected());
+}
+
+TEST_CASE("Frozen signals / slots") {
+    using t1::B;
+
+    using sigslot = pfs::sigslot<pfs::active_queue<>>;
+
+    class D : public sigslot::slot_holder
+    {
+    public:
+        int counter = 0;
+        void slot (int) { counter++; }
+    };
+
+    B b;
+    D d;
+    sigslot::signal<int> sig;
+
+    CHECK(sig.connect(& b, static_cast<void (B::*)(int)>(& B::slot)));
+    CHECK(sig.connect(& d, & D::slot));
+
+    sig.freeze();
+    CHECK(sig.is_frozen());
+
+    sig(42);
+    sig(43);
+
+    CHECK(d.counter == 2);
+    CHECK(b.callback_queue().count() == 2);
+
+    b.callback_queue().call_all();
+    CHECK(b.counter == 2);
+
+    // No emission in progress, delegates may be dropped
+    sig.unfreeze();
+    CHECK_FALSE(sig.is_frozen());
+
+    sig.disconnect_all();
+    CHECK_FALSE(sig.is_connected());
+
+    CHECK(sig.connect(& d, & D::slot));
+    sig(44);
+    CHECK(d.counter == 3);
+}
+
+TEST_CASE("Callable slots") {
+    using t0::A;
+    using t1::B;
+    using sigslot = pfs::sigslot<pfs::active_queue<>>;
+
+    class E : public sigslot::slot_holder {};
+
+    E e;
+    B b;
+    int direct_counter = 0;
+    int queued_counter = 0;
+    sigslot::signal<int> sig;
+    sigslot::rcu_signal<int> rcu_sig;
+
+    CHECK(sig.connect(& e, [& direct_counter] (int a) { direct_counter += a; }));
+    CHECK(sig.connect(& b, [& queued_counter] (int a) { queued_counter += a; }));
+
+    std::function<void (int)> f = [& direct_counter] (int a) { direct_counter += a; };
+    rcu_sig.connect(& e, f);
+
+    sig(1);
+    rcu_sig(2);
+
+    CHECK(direct_counter == 3);
+    CHECK(queued_counter == 0);
+
+    b.callback_queue().call_all();
+    CHECK(queued_counter == 1);
+
+    sig.freeze();
+    sig(10);
+    b.callback_queue().call_all();
+
+    CHECK(direct_counter == 13);
+    CHECK(queued_counter == 11);
+
+    sig.unfreeze();
+    sig.disconnect_all();
+    CHECK(e.count() == 1);
+    CHECK(b.count() == 0);
+}
+
+namespace t3 {
+
+using sigslot = pfs::sigslot<pfs::active_queue<>>;
+
+struct payload
+{
+    static int copies;
+    std::vector<int> data;
+
+    payload (std::size_t n) : data(n, 42) {}
+    payload (payload const & other) : data(other.data) { ++copies; }
+    payload (payload && other) = default;
+};
+
+int payload::copies = 0;
+
+class F : public sigslot::queued_slot_holder
+{
+public:
+    std::size_t total = 0;
+
+public:
+    void on_unique (std::unique_ptr<int> p) { total += static_cast<std::size_t>(*p); }
+    void on_payload (payload p) { total += p.data.size(); }
+    void on_payload_ref (payload const & p) { total += p.data.size(); }
+};
+
+} // namespace t3
+
+TEST_CASE("Move-only and shared arguments") {
+    using t3::F;
+    using t3::payload;
+    using t3::sigslot;
+
+    F f1, f2, f3;
+
+    sigslot::signal<std::unique_ptr<int>> sig_unique;
+    CHECK(sig_unique.connect(& f1, & F::on_unique));
+
+    // Move-only arguments can not be delivered to second receiver
+    CHECK_FALSE(sig_unique.connect(& f2, & F::on_unique));
+    CHECK(f2.count() == 0);
+
+    sig_unique(std::unique_ptr<int>(new int(42)));
+    f1.callback_queue().call_all();
+    CHECK(f1.total == 42);
+    CHECK(f2.callback_queue().count() == 0);
+
+    sigslot::rcu_signal<std::unique_ptr<int>> rcu_unique;
+    CHECK(rcu_unique.connect(& f1, & F::on_unique));
+    CHECK_FALSE(rcu_unique.connect(& f2, & F::on_unique));
+    rcu_unique(std::unique_ptr<int>(new int(1)));
+    f1.callback_queue().call_all();
+    CHECK(f1.total == 43);
+    f1.total = 42;
+
+    // Last receiver gets moved arguments
+    sigslot::signal<payload> sig_payload;
+    sig_payload.connect(& f1, & F::on_payload);
+    sig_payload.connect(& f2, & F::on_payload);
+    sig_payload(payload{10});
+    f1.callback_queue().call_all();
+    f2.callback_queue().call_all();
+    CHECK(f1.total == 52);
+    CHECK(f2.total == 10);
+    CHECK(payload::copies == 1);
+
+    // All receivers share single payload (the only copy is made to store it)
+    payload::copies = 0;
+    sigslot::rcu_signal<payload const &> sig_shared;
+    sig_shared.connect(& f1, & F::on_payload_ref);
+    sig_shared.connect(& f2, & F::on_payload_ref);
+    sig_shared.connect(& f3, & F::on_payload_ref);
+    sig_shared.emit_signal_shared(payload{100});
+    f1.callback_queue().call_all();
+    f2.callback_queue().call_all();
+    f3.callback_queue().call_all();
+    CHECK(f1.total == 152);
+    CHECK(f2.total == 110);
+    CHECK(f3.total == 100);
+    CHECK(payload::copies == 1);
+}
+
+TEST_CASE("Inline delivery for queued slots") {
+    using t1::B;
+    using t1::sigslot;
+
+    B b;
+    sigslot::rcu_signal<int> sig;
+    sig.connect(& b, static_cast<void (B::*)(int)>(& B::slot));
+
+    // Disabled by default
+    b.set_consumer_thread();
+    sig(42);
+    CHECK(b.counter == 0);
+    CHECK(b.callback_queue().count() == 1);
+    b.callback_queue().call_all();
+
+    b.set_inline_delivery(true);
+    sig(42);
+    CHECK(b.counter == 2);
+    CHECK(b.callback_queue().count() == 0);
+
+    // Emission from other thread is queued
+    std::thread t([& sig] { sig(42); });
+    t.join();
+    CHECK(b.counter == 2);
+    CHECK(b.callback_queue().count() == 1);
+    b.callback_queue().call_all();
+    CHECK(b.counter == 3);
+
+    // Nesting depth is limited, deeper emissions are queued
+    class G : public sigslot::queued_slot_holder
+    {
+    public:
+        sigslot::rcu_signal<int> * psig = nullptr;
+        int counter = 0;
+        void slot (int n) { counter++; if (n > 0) psig->emit_signal(n - 1); }
+    };
+
+    G g;
+    sigslot::rcu_signal<int> sig_nested;
+    g.psig = & sig_nested;
+    sig_nested.connect(& g, & G::slot);
+    g.set_consumer_thread();
+    g.set_inline_delivery(true, 2);
+
+    sig_nested(5);
+    CHECK(g.counter == 2);
+    CHECK(g.callback_queue().count() == 1);
+}
+
+TEST_CASE("Connection handles") {
+    using t0::A;
+    using t0::sigslot;
+
+    A a;
+    sigslot::signal<int> sig;
+
+    auto h1 = sig.connect(& a, static_cast<void (A::*)(int)>(& A::slot));
+    auto h2 = sig.connect(& a, static_cast<void (A::*)(int)>(& A::slot));
+    CHECK(h1.connected());
+    CHECK(h2.connected());
+    CHECK(a.count() == 2);
+
+    sig(42);
+    CHECK(a.counter == 2);
+
+    // Disconnects exactly one connection
+    CHECK(h1.disconnect());
+    CHECK_FALSE(h1.connected());
+    CHECK_FALSE(h1.disconnect());
+    CHECK(a.count() == 1);
+
+    sig(42);
+    CHECK(a.counter == 3);
+
+    // Handle is reset when connection destroyed by signal
+    sig.disconnect_all();
+    CHECK_FALSE(h2.connected());
+    CHECK(a.count() == 0);
+
+    {
+        sigslot::scoped_connection sc = sig.connect(& a
+            , static_cast<void (A::*)(int)>(& A::slot));
+        CHECK(sc.connected());
+        CHECK(sig.is_connected());
+    }
+
+    CHECK_FALSE(sig.is_connected());
+    CHECK(a.count() == 0);
+
+    // Handle is reset when slot holder destroyed
+    sigslot::connection_handle h3;
+
+    {
+        A a1;
+        h3 = sig.connect(& a1, static_cast<void (A::*)(int)>(& A::slot));
+        CHECK(h3.connected());
+    }
+
+    CHECK_FALSE(h3.connected());
+    CHECK_FALSE(sig.is_connected());
+
+    sigslot::rcu_signal<int> rcu_sig;
+    auto h4 = rcu_sig.connect(& a, static_cast<void (A::*)(int)>(& A::slot));
+    sigslot::connection_handle h5 = rcu_sig.connect(& a, [] (int) {});
+    CHECK(a.count() == 2);
+    CHECK(h4.disconnect());
+    CHECK(a.count() == 1);
+    CHECK(h5.connected());
+    rcu_sig.disconnect_all();
+    CHECK_FALSE(h5.connected());
+    CHECK(a.count() == 0);
+
+    // Handle is detached from destroyed signal
+    sigslot::scoped_connection sc;
+
+    {
+        sigslot::signal<int> sig1;
+        sc = sig1.connect(& a, static_cast<void (A::*)(int)>(& A::slot));
+        CHECK(sc.connected());
+    }
+
+    CHECK_FALSE(sc.connected());
+    CHECK_FALSE(sc.disconnect());
+    CHECK(sc.stats() == nullptr);
+    CHECK(a.count() == 0);
+}
+
+TEST_CASE("Compact slot holders") {
+    using t1::B;
+    using t1::sigslot;
+
+    class H : public sigslot::compact_slot_holder
+    {
+    public:
+        int counter = 0;
+
+        H (sigslot::basic_slot_holder * owner = nullptr)
+            : sigslot::compact_slot_holder(owner)
+        {}
+
+        void slot (int) { counter++; }
+    };
+
+    CHECK(sizeof(sigslot::compact_slot_holder) == 3 * sizeof(void *));
+
+    B owner;
+    sigslot::signal<int> sig;
+
+    std::vector<std::unique_ptr<H>> direct;
+    std::vector<std::unique_ptr<H>> queued;
+
+    for (int i = 0; i < 100; i++) {
+        direct.emplace_back(new H);
+        queued.emplace_back(new H(& owner));
+        sig.connect(direct.back().get(), & H::slot);
+        sig.connect(queued.back().get(), & H::slot);
+    }
+
+    sig(42);
+
+    CHECK(direct.front()->counter == 1);
+    CHECK(queued.front()->counter == 0);
+    CHECK(owner.callback_queue().count() == 100);
+
+    owner.callback_queue().call_all();
+    CHECK(queued.back()->counter == 1);
+
+    auto h = sig.connect(direct.front().get(), [] (int) {});
+    CHECK(direct.front()->count() == 2);
+    CHECK(h.disconnect());
+    CHECK(direct.front()->count() == 1);
+
+    // Destroyed holders are disconnected
+    direct.clear();
+    queued.clear();
+    CHECK_FALSE(sig.is_connected());
+}
+
+TEST_CASE("Concurrent disconnection") {
+    using t1::sigslot;
+
+    class H : public sigslot::compact_slot_holder
+    {
+    public:
+        void slot (int) {}
+    };
+
+    sigslot::signal<int> sig;
+    bool all_reset = true;
+
+    for (int round = 0; round < 200; round++) {
+        std::vector<std::unique_ptr<H>> destroyed;
+        std::vector<std::unique_ptr<H>> kept;
+        std::vector<sigslot::connection_handle> handles;
+
+        // Holders share striped mutexes
+        for (int i = 0; i < 64; i++) {
+            destroyed.emplace_back(new H);
+            kept.emplace_back(new H);
+            sig.connect(destroyed.back().get(), & H::slot);
+            handles.push_back(sig.connect(kept.back().get(), & H::slot));
+        }
+
+        // Holder destruction locks the holder's mutex and the signal,
+        // disconnection by handle locks the signal and the holder's mutex
+        std::thread destroyer([& destroyed] { destroyed.clear(); });
+
+        for (auto & h: handles)
+            h.disconnect();
+
+        destroyer.join();
+
+        for (auto & h: handles)
+            all_reset = all_reset && !h.connected();
+    }
+
+    CHECK(all_reset);
+    CHECK_FALSE(sig.is_connected());
+}
+
+TEST_CASE("Batched emission") {
+    using t1::B;
+    using t1::sigslot;
+
+    class D : public sigslot::slot_holder
+    {
+    public:
+        int sum = 0;
+        void slot (int a, std::string const & s) { sum += a + static_cast<int>(s.size()); }
+    };
+
+    class Q : public sigslot::queued_slot_holder
+    {
+    public:
+        int sum = 0;
+        void slot (int a, std::string const & s) { sum += a + static_cast<int>(s.size()); }
+    };
+
+    D d;
+    Q q;
+    sigslot::signal<int, std::string const &> sig;
+    sig.connect(& d, & D::slot);
+    sig.connect(& q, & Q::slot);
+
+    std::vector<std::tuple<int, std::string>> records {
+          std::make_tuple(1, std::string("a"))
+        , std::make_tuple(2, std::string("bb"))
+        , std::make_tuple(3, std::string("ccc"))
+    };
+
+    sig.emit_batch(records.begin(), records.end());
+
+    CHECK(d.sum == 12);
+    CHECK(q.sum == 0);
+
+    // Whole range is single queue item
+    CHECK(q.callback_queue().count() == 1);
+    q.callback_queue().call_all();
+    CHECK(q.sum == 12);
+
+    sig.freeze();
+    sig.emit_batch(records.begin(), records.end());
+    q.callback_queue().call_all();
+    CHECK(d.sum == 24);
+    CHECK(q.sum == 24);
+
+    sigslot::rcu_signal<int, std::string const &> rcu_sig;
+    rcu_sig.connect(& q, & Q::slot);
+    rcu_sig.emit_batch(std::move(records));
+    CHECK(q.callback_queue().count() == 1);
+    q.callback_queue().call_all();
+    CHECK(q.sum == 36);
+}
+
+TEST_CASE("Batch slots") {
+    using t1::sigslot;
+
+    class Q : public sigslot::queued_slot_holder
+    {
+    public:
+        std::vector<std::size_t> batches;
+        int sum = 0;
+
+        void on_batch (sigslot::batch_span<int> batch)
+        {
+            batches.push_back(batch.size());
+
+            for (auto const & args: batch)
+                sum += std::get<0>(args);
+        }
+    };
+
+    Q q;
+    sigslot::signal<int> sig;
+    sig.connect_batch(& q, & Q::on_batch, 4);
+
+    for (int i = 1; i <= 10; i++)
+        sig(int{i});
+
+    // Single drain item for all pending events
+    CHECK(q.callback_queue().count() == 1);
+    q.callback_queue().call_all();
+    CHECK(q.sum == 55);
+    REQUIRE(q.batches.size() == 3);
+    CHECK(q.batches[0] == 4);
+    CHECK(q.batches[2] == 2);
+
+    // Linger: drain item is pushed when batch is full or by flush_batches()
+    Q q1;
+    sigslot::signal<int> sig1;
+    sig1.connect_batch(& q1, & Q::on_batch, 3, std::chrono::milliseconds(20));
+
+    sig1(1);
+    sig1(2);
+    CHECK(q1.callback_queue().count() == 0);
+    sig1(3);
+    CHECK(q1.callback_queue().count() == 1);
+    q1.callback_queue().call_all();
+    CHECK(q1.sum == 6);
+
+    sig1(4);
+    q1.flush_batches();
+    CHECK(q1.callback_queue().count() == 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    q1.flush_batches();
+    CHECK(q1.callback_queue().count() == 1);
+    q1.callback_queue().call_all();
+    CHECK(q1.sum == 10);
+
+    // Batch emission appends the whole range
+    std::vector<std::tuple<int>> records(5, std::make_tuple(1));
+    sig.emit_batch(records.begin(), records.end());
+    q.callback_queue().call_all();
+    CHECK(q.sum == 60);
+}
+
+TEST_CASE("Throttled, debounced and sampled signals") {
+    using t2::C;
+    using t2::sigslot;
+    using timer_pool = pfs::timer_pool<>;
+
+    timer_pool timers;
+    C c1, c2, c3;
+
+    sigslot::throttled_signal<int> throttled(0.1);
+    throttled.connect(& c1, & C::slot);
+
+    for (int i = 0; i < 1000; i++)
+        throttled(int{i});
+
+    CHECK(c1.counter == 1);
+    CHECK(throttled.emitted_count() == 1);
+    CHECK(throttled.suppressed_count() == 999);
+
+    sigslot::debounced_signal<timer_pool, int> debounced(0.05, & timers);
+    debounced.connect(& c2, & C::slot);
+
+    for (int i = 0; i < 10; i++) {
+        debounced(int{i});
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    CHECK(c2.counter == 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    CHECK(c2.counter == 1);
+    CHECK(debounced.suppressed_count() == 9);
+
+    // Next burst is emitted again after quiet period
+    debounced(42);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    CHECK(c2.counter == 2);
+
+    sigslot::sampled_signal<timer_pool, int> sampled(0.02, & timers);
+    sampled.connect(& c3, & C::slot);
+
+    auto finish = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+
+    while (std::chrono::steady_clock::now() < finish)
+        sampled(42);
+
+    sampled.stop();
+
+    CHECK(c3.counter > 0);
+    CHECK(c3.counter <= 6);
+    CHECK(sampled.emitted_count() == static_cast<std::size_t>(c3.counter));
+    CHECK(sampled.suppressed_count() > 0);
+
+    // Dropped after stop
+    sampled(42);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(sampled.emitted_count() == static_cast<std::size_t>(c3.counter));
+}
+
+TEST_CASE("Connection filters") {
+    using t1::B;
+    using t1::sigslot;
+
+    B b;
+    int direct_counter = 0;
+
+    class E : public sigslot::slot_holder {};
+    E e;
+
+    sigslot::signal<int> sig;
+    sig.connect(& b, static_cast<void (B::*)(int)>(& B::slot)
+        , [] (int kind) { return kind == 1; });
+    sig.connect(& e, [& direct_counter] (int) { direct_counter++; }
+        , [] (int kind) { return kind == 2; });
+
+    for (int i = 0; i < 10; i++)
+        sig(i % 3);
+
+    // Rejected events are not queued
+    CHECK(b.callback_queue().count() == 3);
+    CHECK(direct_counter == 3);
+
+    b.callback_queue().call_all();
+    CHECK(b.counter == 3);
+
+    sig.freeze();
+    sig(1);
+    sig(0);
+    CHECK(b.callback_queue().count() == 1);
+
+    std::vector<std::tuple<int>> records {std::make_tuple(0), std::make_tuple(1), std::make_tuple(1)};
+    sig.emit_batch(records.begin(), records.end());
+    CHECK(b.callback_queue().count() == 2);
+    b.callback_queue().call_all();
+    CHECK(b.counter == 6);
+
+    sigslot::rcu_signal<int> rcu_sig;
+    rcu_sig.connect(& b, static_cast<void (B::*)(int)>(& B::slot)
+        , [] (int kind) { return kind > 0; });
+    rcu_sig(0);
+    rcu_sig(1);
+    CHECK(b.callback_queue().count() == 1);
+}
+
+namespace t4 {
+
+using sigslot = pfs::sigslot<pfs::active_queue<>, std::mutex, pfs::profiling_policy>;
+
+class P : public sigslot::queued_slot_holder
+{
+public:
+    int counter = 0;
+
+public:
+    void slot (int n)
+    {
+        counter += n;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+};
+
+class D : public sigslot::slot_holder
+{
+public:
+    int counter = 0;
+
+public:
+    void slot (int n) { counter += n; }
+};
+
+} // namespace t4
+
+TEST_CASE("Emission profiling") {
+    using t4::sigslot;
+    using t4::P;
+    using t4::D;
+
+    P p;
+    D d;
+
+    sigslot::signal<int> sig;
+    auto hp = sig.connect(& p, & P::slot);
+    auto hd = sig.connect(& d, & D::slot);
+
+    for (int i = 0; i < 5; i++)
+        sig(1);
+
+    std::vector<std::tuple<int>> records {std::make_tuple(1), std::make_tuple(1)};
+    sig.emit_batch(records.begin(), records.end());
+
+    CHECK(sig.stats()->emissions() == 7);
+    CHECK(hd.stats()->snapshot().deliveries == 6);
+
+    // Queued deliveries are measured when queue item is called
+    auto queued_stats = hp.stats();
+    CHECK(queued_stats->snapshot().deliveries == 0);
+
+    // Statistics outlive the connection
+    hp.disconnect();
+    CHECK(!hp.stats());
+    p.callback_queue().call_all();
+
+    auto snapshot = queued_stats->snapshot();
+    CHECK(snapshot.deliveries == 6);
+    CHECK(snapshot.total_ns >= 6 * 1000000u);
+    CHECK(snapshot.max_ns >= 1000000u);
+    CHECK(snapshot.p50_ns >= 1000000u);
+    CHECK(snapshot.p99_ns >= snapshot.p50_ns);
+
+    sigslot::rcu_signal<int> rcu_sig;
+    auto hr = rcu_sig.connect(& d, & D::slot);
+    rcu_sig(1);
+    CHECK(rcu_sig.stats()->emissions() == 1);
+    CHECK(hr.stats()->snapshot().deliveries == 1);
+
+    // Statistics are compiled out by default
+    t0::sigslot::signal<int> plain_sig;
+    CHECK(!plain_sig.stats());
+}
+
+TEST_CASE("benchmark") {
+    using t0::A;
+    using t0::sigslot;
+
+    class E : public sigslot::slot_holder {};
+
+    A a;
+    E e;
+    int counter = 0;
+
+    sigslot::signal<int> sig_method;
+    sigslot::signal<int> sig_lambda;
+
+    sig_method.connect(& a, static_cast<void (A::*)(int)>(& A::slot));
+    sig_lambda.connect(& e, [& counter] (int) { counter++; });
+
+    ankerl::nanobench::Bench().minEpochIterations(100000).run("emit: member pointer", [&] {
+        sig_method(42);
+    });
+
+    ankerl::nanobench::Bench().minEpochIterations(100000).run("emit: lambda", [&] {
+        sig_lambda(42);
+    });
+
+    sig_method.freeze();
+    sig_lambda.freeze();
+
+    ankerl::nanobench::Bench().minEpochIterations(100000).run("emit: member pointer (frozen)", [&] {
+        sig_method(42);
+    });
+
+    ankerl::nanobench::Bench().minEpochIterations(100000).run("emit: lambda (frozen)", [&] {
+        sig_lambda(42);
+    });
+
+    // Cost of the profiling (plain signal above has it compiled out)
+    {
+        t4::D d;
+        t4::sigslot::signal<int> sig_profiled;
+        sig_profiled.connect(& d, & t4::D::slot);
+
+        ankerl::nanobench::Bench().minEpochIterations(100000).run("emit: member pointer (profiled)", [&] {
+            sig_profiled(42);
+        });
+
+        CHECK(d.counter > 0);
+    }
+
+    CHECK(a.counter > 0);
+    CHECK(counter > 0);
+
+    // Per-record vs batched emission to queued slot
+    {
+        using t1::B;
+        using queued_sigslot = t1::sigslot;
+
+        B b;
+        queued_sigslot::signal<int> sig;
+        sig.connect(& b, static_cast<void (B::*)(int)>(& B::slot));
+
+        std::vector<std::tuple<int>> records(1000, std::make_tuple(42));
+
+        ankerl::nanobench::Bench().minEpochIterations(100).run("emit 1000 records: one by one", [&] {
+            for (auto const & r: records)
+                sig(int{std::get<0>(r)});
+
+            b.callback_queue().call_all();
+        });
+
+        ankerl::nanobench::Bench().minEpochIterations(100).run("emit 1000 records: batch", [&] {
+            sig.emit_batch(records.begin(), records.end());
+            b.callback_queue().call_all();
+        });
+
+        CHECK(b.counter > 0);
+    }
+
+    // Per-holder memory overhead and connect/disconnect cost for large
+    // number of holders
+    class H : public sigslot::compact_slot_holder
+    {
+    public:
+        void slot (int) {}
+    };
+
+    std::printf("sizeof(slot_holder)         = %zu\n", sizeof(sigslot::slot_holder));
+    std::printf("sizeof(compact_slot_holder) = %zu\n", sizeof(sigslot::compact_slot_holder));
+
+    static constexpr int holders_count = 100000;
+
+    ankerl::nanobench::Bench().epochs(5).run("100k slot holders: create/connect/destroy", [&] {
+        sigslot::signal<int> sig;
+        std::unique_ptr<A[]> holders(new A[holders_count]);
+
+        for (int i = 0; i < holders_count; i++)
+            sig.connect(& holders[i], static_cast<void (A::*)(int)>(& A::slot));
+    });
+
+    ankerl::nanobench::Bench().epochs(5).run("100k compact slot holders: create/connect/destroy", [&] {
+        sigslot::signal<int> sig;
+        std::unique_ptr<H[]> holders(new H[holders_count]);
+
+        for (int i = 0; i < holders_count; i++)
+            sig.connect(& holders[i], & H::slot);
+    });
+}
@@ -5,11 +5,81 @@
 //
 // Changelog:
 //      2020.01.15 Initial version
+//      2026.10.18 Added timing wheel tests and benchmark.
+//      2026.10.18 Added std::chrono API tests and jitter benchmark.
+//      2026.10.18 Added timer slack tests and wakeups benchmark.
+//      2026.10.18 Added callback executor tests.
+//      2026.10.18 Added timerfd waiter tests.
+//      2026.10.18 Added missed tick policy tests.
+//      2026.10.18 Added command inbox tests and arming benchmark.
+//      2026.10.18 Added asynchronous cancellation tests.
+//      2026.10.18 Added allocation-free timers tests.
+//      2026.10.18 Added timer owners tests.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define ANKERL_NANOBENCH_IMPLEMENT
 #include "doctest.h"
+#include "nanobench.h"
 #include "pfs/timer.hpp"
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#   include <poll.h>
+#endif
+
+using wheel_timer_pool = pfs::timer_pool<pfs::default_timer_associative_container
+    , std::mutex
+    , std::condition_variable
+    , std::unique_lock
+    , pfs::timing_wheel_timer_queue>;
+
+using fine_wheel_timer_pool = pfs::timer_pool<pfs::default_timer_associative_container
+    , std::mutex
+    , std::condition_variable
+    , std::unique_lock
+    , pfs::basic_timing_wheel_timer_queue<std::chrono::microseconds>>;
+
+using executor_timer_pool = pfs::timer_pool<pfs::default_timer_associative_container
+    , std::mutex
+    , std::condition_variable
+    , std::unique_lock
+    , pfs::multiset_timer_queue
+    , pfs::thread_pool_timer_executor>;
+
+// Lets test wait for callbacks without guessing their timing (wait is bounded,
+// so lost callback fails the test instead of hanging it)
+class countdown_latch
+{
+    std::mutex _mtx;
+    std::condition_variable _cv;
+    int _count;
+
+public:
+    explicit countdown_latch (int count) : _count(count) {}
+
+    void count_down ()
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+
+        if (_count > 0 && --_count == 0)
+            _cv.notify_all();
+    }
+
+    bool wait ()
+    {
+        std::unique_lock<std::mutex> lock(_mtx);
+        return _cv.wait_for(lock, std::chrono::seconds(5), [this] { return _count == 0; });
+    }
+};
 
 TEST_CASE("Basic timer") {
     using timer_pool = pfs::timer_pool<>;
@@ -39,3 +109,1052 @@ TEST_CASE("Basic timer") {
     CHECK(t2 > 3);
     CHECK(t3 > 10);
 }
+
+// Checks that timers fire not earlier than requested and cancelled timers
+// do not fire
+template <typename TimerPool>
+void check_timer_queue ()
+{
+    using clock_type = std::chrono::steady_clock;
+
+    TimerPool tm;
+    int const count = 1000;
+    std::atomic_int fired {0};
+    std::atomic_int early {0};
+    std::atomic_int periodic {0};
+    std::vector<typename TimerPool::timer_id> ids;
+
+    auto start = clock_type::now();
+
+    for (int i = 0; i < count; i++) {
+        double delay = 0.1 + 0.001 * (i % 200);
+        auto deadline = start + std::chrono::milliseconds(100 + i % 200);
+
+        ids.push_back(tm.create(delay, 0, [& fired, & early, deadline] {
+            if (clock_type::now() < deadline)
+                ++early;
+
+            ++fired;
+        }));
+    }
+
+    // Same deadline for many timers, cancel every second one
+    for (int i = 1; i < count; i += 2)
+        CHECK(tm.destroy(ids[i]));
+
+    // Far timer is kept until destroyed
+    auto far_id = tm.create(3600, 0, [& fired] { ++fired; });
+    tm.create(0.05, 0.05, [& periodic] { ++periodic; });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(700));
+
+    CHECK(fired == count / 2);
+    CHECK(early == 0);
+    CHECK(periodic >= 5);
+    CHECK(tm.size() == 2);
+    CHECK(tm.destroy(far_id));
+    CHECK_FALSE(tm.destroy(far_id));
+
+    tm.destroy_all();
+    CHECK(tm.empty());
+}
+
+TEST_CASE("Multiset timer queue") {
+    check_timer_queue<pfs::timer_pool<>>();
+}
+
+TEST_CASE("Timing wheel timer queue") {
+    check_timer_queue<wheel_timer_pool>();
+}
+
+#if defined(__linux__)
+using timerfd_timer_pool = pfs::timer_pool<pfs::default_timer_associative_container
+    , std::mutex
+    , std::condition_variable
+    , std::unique_lock
+    , pfs::multiset_timer_queue
+    , pfs::inline_timer_executor
+    , pfs::timerfd_timer_waiter>;
+
+TEST_CASE("Timerfd waiter") {
+    using namespace std::chrono;
+
+    check_timer_queue<timerfd_timer_pool>();
+
+    // Timers serviced by external event loop
+    timerfd_timer_pool tm;
+    tm.use_external_loop();
+    REQUIRE(tm.native_handle() >= 0);
+
+    auto loop_thread = std::this_thread::get_id();
+    auto start = steady_clock::now();
+    int periodic = 0;
+    int single = 0;
+    int foreign = 0;
+
+    tm.create(milliseconds(10), milliseconds(10), [&] {
+        ++periodic;
+
+        if (std::this_thread::get_id() != loop_thread)
+            ++foreign;
+    });
+
+    auto single_id = tm.create(milliseconds(30), milliseconds(0), [&] { ++single; });
+    auto cancelled_id = tm.create(milliseconds(5), milliseconds(0), [&] { ++single; });
+    CHECK(tm.destroy(cancelled_id));
+
+    auto deadline = steady_clock::now() + milliseconds(105);
+    std::size_t fired = 0;
+
+    while (steady_clock::now() < deadline) {
+        pollfd pfd;
+        pfd.fd = tm.native_handle();
+        pfd.events = POLLIN;
+
+        if (::poll(& pfd, 1, 10) > 0)
+            fired += tm.process_expired();
+    }
+
+    CHECK(single == 1);
+    CHECK_FALSE(tm.destroy(single_id));
+    CHECK(periodic >= 5);
+    CHECK(periodic <= (steady_clock::now() - start) / milliseconds(10));
+    CHECK(foreign == 0);
+    CHECK(fired == static_cast<std::size_t>(periodic + single));
+    CHECK(tm.fired_count() == fired);
+}
+#endif
+
+TEST_CASE("Timer callback executors") {
+    using namespace std::chrono;
+
+    check_timer_queue<executor_timer_pool>();
+
+    // Slow callback does not delay other timers
+    {
+        countdown_latch fast_ticks {5};
+        countdown_latch release {1};
+        std::atomic_bool slow_done {false};
+
+        executor_timer_pool tm;
+        tm.executor().set_thread_count(2);
+
+        tm.create(milliseconds(0), milliseconds(0), [& release, & slow_done] {
+            release.wait();
+            slow_done = true;
+        });
+
+        tm.create(milliseconds(10), milliseconds(10), [& fast_ticks] { fast_ticks.count_down(); });
+
+        CHECK(fast_ticks.wait());
+        CHECK_FALSE(slow_done);
+        release.count_down();
+    }
+
+    // Periodic callbacks of the same timer never overlap
+    {
+        countdown_latch ten_calls {10};
+        std::atomic_int running {0};
+        std::atomic_int overlaps {0};
+        std::atomic_int calls {0};
+
+        executor_timer_pool tm;
+        tm.executor().set_thread_count(4);
+
+        tm.create(milliseconds(1), milliseconds(1), [&] {
+            if (++running > 1)
+                ++overlaps;
+
+            std::this_thread::sleep_for(milliseconds(5));
+            --running;
+            ++calls;
+            ten_calls.count_down();
+        });
+
+        CHECK(ten_calls.wait());
+        tm.destroy_all();
+
+        CHECK(calls >= 10);
+        CHECK(overlaps == 0);
+    }
+
+    // Destroy waits for running callback, callback may destroy own timer
+    {
+        countdown_latch started {1};
+        countdown_latch self_fired {1};
+        std::atomic_bool finished {false};
+        std::atomic_int self_destroyed {0};
+
+        executor_timer_pool tm;
+
+        auto id = tm.create(milliseconds(0), milliseconds(0), [& started, & finished] {
+            started.count_down();
+            std::this_thread::sleep_for(milliseconds(50));
+            finished = true;
+        });
+
+        CHECK(started.wait());
+        CHECK(tm.destroy(id));
+        CHECK(finished);
+
+        std::atomic<executor_timer_pool::timer_id> self_id {0};
+
+        self_id = tm.create(milliseconds(0), milliseconds(5), [&] {
+            auto id = self_id.load();
+
+            // Fired before create() returned
+            if (id == 0)
+                return;
+
+            if (tm.destroy(id))
+                ++self_destroyed;
+
+            self_fired.count_down();
+        });
+
+        CHECK(self_fired.wait());
+
+        // Waits for the callback to return
+        tm.destroy_all();
+        CHECK(self_destroyed == 1);
+        CHECK(tm.empty());
+    }
+
+    // Callback destroys timer which callback is running by other thread of
+    // the pool
+    {
+        countdown_latch b_started {1};
+        countdown_latch a_done {1};
+        std::atomic_bool b_finished {false};
+        std::atomic_bool b_destroyed {false};
+        std::atomic_bool b_finished_before {false};
+
+        executor_timer_pool tm;
+        tm.executor().set_thread_count(2);
+
+        auto b = tm.create(milliseconds(0), milliseconds(0), [& b_started, & b_finished] {
+            b_started.count_down();
+            std::this_thread::sleep_for(milliseconds(50));
+            b_finished = true;
+        });
+
+        CHECK(b_started.wait());
+
+        tm.create(milliseconds(0), milliseconds(0), [&] {
+            b_destroyed = tm.destroy(b);
+            b_finished_before = b_finished.load();
+            a_done.count_down();
+        });
+
+        CHECK(a_done.wait());
+        CHECK(b_destroyed);
+        CHECK(b_finished_before);
+    }
+
+    // Callback destroys timer which callback is queued behind it (single
+    // thread of the pool is busy), queued callback is not called
+    {
+        countdown_latch a_done {1};
+        std::atomic_int b_calls {0};
+
+        {
+            executor_timer_pool tm;
+            tm.executor().set_thread_count(1);
+
+            tm.create(milliseconds(0), milliseconds(0), [& tm, & a_done, & b_calls] {
+                auto b = tm.create(milliseconds(0), milliseconds(0), [& b_calls] { ++b_calls; });
+
+                // Let timer thread pass B to the executor (B is destroyed
+                // before it is fired otherwise, the result is the same)
+                std::this_thread::sleep_for(milliseconds(20));
+
+                CHECK(tm.destroy(b));
+                a_done.count_down();
+            });
+
+            CHECK(a_done.wait());
+        }
+
+        CHECK(b_calls == 0);
+    }
+}
+
+TEST_CASE("Sub-millisecond timers") {
+    using namespace std::chrono;
+    using clock_type = steady_clock;
+
+    {
+        pfs::timer_pool<> tm;
+        tm.set_spin_threshold(microseconds(200));
+
+        std::atomic_int ticks {0};
+        std::atomic_int at_fired {0};
+        auto start = clock_type::now();
+        auto at = start + microseconds(1500);
+        std::atomic<clock_type::rep> at_time {0};
+
+        auto ticks_id = tm.create(microseconds(100), microseconds(100), [& ticks] { ++ticks; });
+        tm.create(at, nanoseconds(0), [& at_fired, & at_time] {
+            at_time = clock_type::now().time_since_epoch().count();
+            ++at_fired;
+        });
+
+        std::this_thread::sleep_for(milliseconds(100));
+        tm.destroy(ticks_id);
+        auto elapsed = clock_type::now() - start;
+
+        CHECK(at_fired == 1);
+        CHECK(at_time >= at.time_since_epoch().count());
+
+        // Never fires ahead of schedule, allow falling behind on noisy hosts
+        CHECK(ticks > 0);
+        CHECK(ticks <= elapsed / microseconds(100));
+    }
+}
+
+template <typename TimerPool>
+void check_timer_slack ()
+{
+    using namespace std::chrono;
+    using clock_type = steady_clock;
+
+    TimerPool tm;
+    int const count = 200;
+    auto const slack = milliseconds(16);
+    std::atomic_int fired {0};
+    std::atomic_int early {0};
+    std::atomic_int late {0};
+
+    auto start = clock_type::now();
+
+    for (int i = 0; i < count; i++) {
+        auto delay = milliseconds(200) + microseconds(100 * i);
+        auto deadline = start + delay;
+        auto callback = [& fired, & early, & late, deadline, slack] {
+            auto now = clock_type::now();
+
+            if (now < deadline)
+                ++early;
+
+            // Allow scheduling latency
+            if (now > deadline + slack + milliseconds(50))
+                ++late;
+
+            ++fired;
+        };
+
+        // Half of timers get slack from pool default
+        if (i % 2) {
+            tm.create(delay, nanoseconds(0), slack, callback);
+        } else {
+            tm.set_default_slack(slack);
+            tm.create(delay, nanoseconds(0), callback);
+        }
+    }
+
+    auto wakeups = tm.wakeups_count();
+    std::this_thread::sleep_for(milliseconds(500));
+
+    CHECK(fired == count);
+    CHECK(early == 0);
+    CHECK(late == 0);
+
+    // Expiration times span 20 ms, so few grid steps
+    CHECK(tm.wakeups_count() - wakeups <= 10);
+}
+
+TEST_CASE("Timer slack") {
+    check_timer_slack<pfs::timer_pool<>>();
+    check_timer_slack<wheel_timer_pool>();
+}
+
+template <typename TimerPool>
+void check_missed_ticks ()
+{
+    using namespace std::chrono;
+    using clock_type = steady_clock;
+
+    auto const period = milliseconds(10);
+    auto const stall = milliseconds(55);
+
+    struct probe
+    {
+        std::mutex mtx;
+        std::vector<clock_type::time_point> starts;
+        std::vector<clock_type::time_point> ends;
+    };
+
+    // First callback stalls for more than five periods
+    auto run = [period, stall] (TimerPool & tm, probe & p) {
+        return tm.create(milliseconds(100), period, [& p, stall] {
+            std::unique_lock<std::mutex> locker(p.mtx);
+            bool first = p.starts.empty();
+            p.starts.push_back(clock_type::now());
+            locker.unlock();
+
+            if (first)
+                std::this_thread::sleep_for(stall);
+
+            locker.lock();
+            p.ends.push_back(clock_type::now());
+        });
+    };
+
+    auto wait_ticks = [] (probe & p, std::size_t n) {
+        for (int i = 0; i < 200; i++) {
+            {
+                std::unique_lock<std::mutex> locker(p.mtx);
+
+                if (p.ends.size() >= n)
+                    return true;
+            }
+
+            std::this_thread::sleep_for(milliseconds(10));
+        }
+
+        return false;
+    };
+
+    // Catch-up fires all missed ticks
+    {
+        TimerPool tm;
+        probe p;
+        auto id = run(tm, p);
+        REQUIRE(wait_ticks(p, 3));
+        CHECK(tm.missed_ticks(id) == 0);
+        CHECK(tm.missed_ticks_count() == 0);
+        tm.destroy(id);
+    }
+
+    // Catch-up with cap skips the rest
+    {
+        TimerPool tm;
+        tm.set_default_missed_tick_policy(pfs::missed_tick_policy::catch_up, 2);
+        probe p;
+        auto id = run(tm, p);
+        REQUIRE(wait_ticks(p, 3));
+        CHECK(tm.missed_ticks(id) >= 3);
+        CHECK(tm.missed_ticks_count() == tm.missed_ticks(id));
+        tm.destroy(id);
+    }
+
+    // Skip fires once and keeps phase
+    {
+        TimerPool tm;
+        probe p;
+        auto id = run(tm, p);
+        CHECK(tm.set_missed_tick_policy(id, pfs::missed_tick_policy::skip));
+        REQUIRE(wait_ticks(p, 2));
+        CHECK(tm.missed_ticks(id) >= 5);
+
+        std::unique_lock<std::mutex> locker(p.mtx);
+        CHECK(p.starts[1] - p.starts[0] >= stall);
+        CHECK(p.starts[1] >= p.ends[0]);
+        locker.unlock();
+        tm.destroy(id);
+    }
+
+    // Fixed delay counts period from callback completion
+    {
+        TimerPool tm;
+        probe p;
+        auto id = run(tm, p);
+        CHECK(tm.set_missed_tick_policy(id, pfs::missed_tick_policy::fixed_delay));
+        REQUIRE(wait_ticks(p, 3));
+        CHECK(tm.missed_ticks(id) == 0);
+
+        std::unique_lock<std::mutex> locker(p.mtx);
+        CHECK(p.starts[1] - p.ends[0] >= period);
+        CHECK(p.starts[2] - p.ends[1] >= period);
+        locker.unlock();
+        tm.destroy(id);
+    }
+
+    TimerPool tm;
+    CHECK_FALSE(tm.set_missed_tick_policy(12345, pfs::missed_tick_policy::skip));
+    CHECK(tm.missed_ticks(12345) == 0);
+}
+
+TEST_CASE("Missed ticks") {
+    check_missed_ticks<pfs::timer_pool<>>();
+    check_missed_ticks<wheel_timer_pool>();
+}
+
+// Timers created and cancelled from many threads through command inbox
+template <typename TimerPool>
+void check_command_inbox ()
+{
+    using namespace std::chrono;
+    using clock_type = steady_clock;
+
+    TimerPool tm;
+    int const threads = 4;
+    int const count = 500;
+    std::atomic_int fired {0};
+    std::atomic_int early {0};
+    std::vector<std::vector<typename TimerPool::timer_id>> ids(threads);
+    std::vector<std::thread> producers;
+
+    for (int t = 0; t < threads; t++) {
+        producers.emplace_back([& tm, & fired, & early, & ids, t, count] {
+            for (int i = 0; i < count; i++) {
+                auto delay = milliseconds(100 + i % 50);
+                auto deadline = clock_type::now() + delay;
+
+                ids[t].push_back(tm.post_create(delay, milliseconds(0)
+                    , [& fired, & early, deadline] {
+                        if (clock_type::now() < deadline)
+                            ++early;
+
+                        ++fired;
+                    }));
+            }
+
+            // Cancel every second one
+            for (int i = 1; i < count; i += 2)
+                tm.post_destroy(ids[t][i]);
+        });
+    }
+
+    for (auto & p: producers)
+        p.join();
+
+    // IDs are unique
+    std::vector<typename TimerPool::timer_id> all;
+
+    for (auto const & v: ids)
+        all.insert(all.end(), v.begin(), v.end());
+
+    std::sort(all.begin(), all.end());
+    CHECK(std::unique(all.begin(), all.end()) == all.end());
+
+    // Posted timer is visible for locked API immediately
+    std::atomic_int periodic {0};
+    auto far_id = tm.post_create(seconds(3600), milliseconds(0), [] {});
+    auto periodic_id = tm.post_create(milliseconds(10), milliseconds(10)
+        , [& periodic] { ++periodic; });
+    CHECK(tm.destroy(far_id));
+
+    for (int i = 0; i < 300 && fired < threads * count / 2; i++)
+        std::this_thread::sleep_for(milliseconds(10));
+
+    CHECK(fired == threads * count / 2);
+    CHECK(early == 0);
+
+    for (int i = 0; i < 300 && periodic == 0; i++)
+        std::this_thread::sleep_for(milliseconds(10));
+
+    CHECK(periodic > 0);
+    tm.post_destroy(periodic_id);
+
+    // Destroy is processed by next wakeup, timer is gone with its callback
+    for (int i = 0; i < 300 && !tm.empty(); i++)
+        std::this_thread::sleep_for(milliseconds(10));
+
+    CHECK(tm.empty());
+    auto ticks = periodic.load();
+    std::this_thread::sleep_for(milliseconds(50));
+    CHECK(periodic == ticks);
+    CHECK_FALSE(tm.destroy(periodic_id));
+}
+
+TEST_CASE("Timer command inbox") {
+    check_command_inbox<pfs::timer_pool<>>();
+    check_command_inbox<wheel_timer_pool>();
+
+#if defined(__linux__)
+    check_command_inbox<timerfd_timer_pool>();
+
+    // Timer posted from foreign thread wakes up external loop
+    using namespace std::chrono;
+
+    timerfd_timer_pool tm;
+    tm.use_external_loop();
+
+    std::atomic_int fired {0};
+
+    std::thread producer {[& tm, & fired] {
+        std::this_thread::sleep_for(milliseconds(20));
+        tm.post_create(milliseconds(0), milliseconds(0), [& fired] { ++fired; });
+    }};
+
+    auto start = steady_clock::now();
+
+    // No timers yet, so loop is woken up by posted command only
+    while (fired == 0 && steady_clock::now() - start < seconds(5)) {
+        pollfd pfd;
+        pfd.fd = tm.native_handle();
+        pfd.events = POLLIN;
+
+        if (::poll(& pfd, 1, 5000) > 0)
+            tm.process_expired();
+    }
+
+    producer.join();
+    CHECK(fired == 1);
+    CHECK(steady_clock::now() - start < seconds(2));
+#endif
+}
+
+template <typename TimerPool>
+void bench_timer_queue (std::string const & name, int count)
+{
+    auto suffix = name + " (" + std::to_string(count) + ")";
+
+    // Timeouts mostly cancelled before firing
+    {
+        TimerPool tm;
+        std::vector<typename TimerPool::timer_id> ids(count);
+
+        ankerl::nanobench::Bench().epochs(3).epochIterations(1).batch(count)
+            .unit("timer").run("create/cancel: " + suffix, [&] {
+                for (int i = 0; i < count; i++)
+                    ids[i] = tm.create(60 + 0.001 * (i % 1000), 0, [] {});
+
+                for (int i = 0; i < count; i++)
+                    tm.destroy(ids[i]);
+            });
+    }
+
+    // Timers fired by worker within 50 ms
+    {
+        TimerPool tm;
+
+        ankerl::nanobench::Bench().epochs(3).epochIterations(1).batch(count)
+            .unit("timer").run("fire: " + suffix, [&] {
+                auto target = tm.fired_count() + count;
+
+                for (int i = 0; i < count; i++)
+                    tm.create(0.001 * (i % 50), 0, [] {});
+
+                while (tm.fired_count() < target)
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+            });
+    }
+}
+
+template <typename TimerPool>
+void check_cancel_async ()
+{
+    using namespace std::chrono;
+    using clock_type = steady_clock;
+
+    auto const period = milliseconds(10);
+    auto const busy = milliseconds(100);
+
+    // Callback is not running, completion is called immediately
+    {
+        TimerPool tm;
+        std::atomic_int fired {0};
+        auto caller = std::this_thread::get_id();
+        std::thread::id completion_thread;
+
+        auto id = tm.create(seconds(3600), seconds(0), [& fired] { ++fired; });
+
+        CHECK(tm.cancel_async(id, [& completion_thread] {
+            completion_thread = std::this_thread::get_id();
+        }));
+
+        CHECK(completion_thread == caller);
+        CHECK(tm.empty());
+        CHECK_FALSE(tm.cancel_async(id));
+    }
+
+    // Callback is running, cancellation does not wait for it
+    {
+        TimerPool tm;
+        std::atomic_int fired {0};
+        std::atomic_bool in_callback {false};
+        std::atomic_bool returned {false};
+        std::atomic_bool completed {false};
+        std::atomic_bool completed_after_return {false};
+
+        auto id = tm.create(milliseconds(0), period, [&] {
+            ++fired;
+            in_callback = true;
+            std::this_thread::sleep_for(busy);
+            returned = true;
+        });
+
+        while (!in_callback)
+            std::this_thread::yield();
+
+        auto start = clock_type::now();
+
+        CHECK(tm.cancel_async(id, [&] {
+            completed_after_return = returned.load();
+            completed = true;
+        }));
+
+        CHECK(clock_type::now() - start < busy);
+
+        for (int i = 0; i < 300 && !completed; i++)
+            std::this_thread::sleep_for(milliseconds(10));
+
+        CHECK(completed);
+        CHECK(completed_after_return);
+
+        // Periodic timer is not rescheduled
+        std::this_thread::sleep_for(period * 5);
+        CHECK(fired == 1);
+        CHECK(tm.empty());
+    }
+
+    // Blocking destroy of cancelled timer waits for running callback
+    {
+        TimerPool tm;
+        std::atomic_bool in_callback {false};
+        std::atomic_bool returned {false};
+        int completions = 0;
+
+        auto id = tm.create(milliseconds(0), period, [&] {
+            in_callback = true;
+            std::this_thread::sleep_for(busy);
+            returned = true;
+        });
+
+        while (!in_callback)
+            std::this_thread::yield();
+
+        CHECK(tm.cancel_async(id, [& completions] { ++completions; }));
+        CHECK(tm.cancel_async(id, [& completions] { ++completions; }));
+        CHECK(tm.destroy(id));
+        CHECK(returned);
+        CHECK(completions == 2);
+    }
+
+    // Timer cancels itself from its callback
+    {
+        TimerPool tm;
+        std::atomic_int fired {0};
+        std::atomic_bool completed {false};
+        std::atomic<typename TimerPool::timer_id> id {0};
+
+        id = tm.create(milliseconds(20), period, [&] {
+            ++fired;
+            CHECK(tm.cancel_async(id, [& completed] { completed = true; }));
+        });
+
+        for (int i = 0; i < 300 && !completed; i++)
+            std::this_thread::sleep_for(milliseconds(10));
+
+        std::this_thread::sleep_for(period * 5);
+        CHECK(completed);
+        CHECK(fired == 1);
+        CHECK(tm.empty());
+    }
+}
+
+TEST_CASE("Asynchronous cancellation") {
+    check_cancel_async<pfs::timer_pool<>>();
+    check_cancel_async<executor_timer_pool>();
+}
+
+// Steady state timers (periodic ticks, timeouts created and cancelled)
+// do not allocate (node pools request no more memory from operator new)
+template <typename TimerPool>
+void check_allocation_free ()
+{
+    using namespace std::chrono;
+
+    TimerPool tm;
+    int const count = 100;
+    std::atomic_int fired {0};
+    std::vector<typename TimerPool::timer_id> ids(count);
+
+    for (int i = 0; i < count; i++)
+        tm.create(milliseconds(1), milliseconds(1), [& fired] { ++fired; });
+
+    auto churn = [& tm, & ids, count] {
+        for (int i = 0; i < count; i++)
+            ids[i] = tm.create(seconds(60), seconds(0), [] {});
+
+        for (int i = 0; i < count; i++)
+            tm.destroy(ids[i]);
+    };
+
+    // Warm up pools
+    churn();
+
+    while (fired < count * 5)
+        std::this_thread::sleep_for(milliseconds(1));
+
+    auto before = pfs::timer_details::node_pool::system_allocations();
+    auto fired_before = fired.load();
+
+    for (int i = 0; i < 10; i++)
+        churn();
+
+    while (fired < fired_before + count * 10)
+        std::this_thread::sleep_for(milliseconds(1));
+
+    auto after = pfs::timer_details::node_pool::system_allocations();
+
+    CHECK(after - before == 0);
+}
+
+using pooled_timer_pool = pfs::timer_pool<pfs::pooled_timer_associative_container>;
+
+using pooled_wheel_timer_pool = pfs::timer_pool<pfs::pooled_timer_associative_container
+    , std::mutex
+    , std::condition_variable
+    , std::unique_lock
+    , pfs::timing_wheel_timer_queue>;
+
+TEST_CASE("Allocation-free timers") {
+    check_allocation_free<pooled_timer_pool>();
+    check_allocation_free<pooled_wheel_timer_pool>();
+
+    // Pool reuses blocks of the same size class
+    using pfs::timer_details::node_pool;
+
+    node_pool pool;
+    auto before = node_pool::system_allocations();
+    auto a = pool.allocate(40);
+    CHECK(node_pool::system_allocations() == before + 1);
+    pool.deallocate(a, 40);
+    CHECK(pool.allocate(48) == a);
+    CHECK(node_pool::system_allocations() == before + 1);
+
+    // Large blocks are not pooled
+    auto big = pool.allocate(1024);
+    CHECK(node_pool::system_allocations() == before + 2);
+    pool.deallocate(big, 1024);
+}
+
+template <typename TimerPool>
+void check_timer_owners ()
+{
+    using namespace std::chrono;
+
+    TimerPool tm;
+    int a = 0, b = 0, c = 0, d = 0;
+    std::atomic_int fired {0};
+
+    for (int i = 0; i < 3; i++)
+        tm.create(& a, seconds(60), seconds(0), [] {});
+
+    auto b_id = tm.create(& b, 60, 0, [] {});
+    tm.create(& b, milliseconds(5), milliseconds(5), [& fired] { ++fired; });
+    tm.create(seconds(60), seconds(0), [] {});
+
+    // Fired single shot timer leaves its owner
+    tm.create(& a, milliseconds(0), milliseconds(0), [& fired] { ++fired; });
+
+    for (int i = 0; i < 300 && fired < 3; i++)
+        std::this_thread::sleep_for(milliseconds(10));
+
+    CHECK(tm.size(& a) == 3);
+    CHECK(tm.size(& b) == 2);
+    CHECK(tm.size(& c) == 0);
+    CHECK(tm.size() == 6);
+
+    CHECK(tm.destroy(b_id));
+    CHECK(tm.size(& b) == 1);
+
+    CHECK(tm.destroy_all(& a) == 3);
+    CHECK(tm.size(& a) == 0);
+    CHECK(tm.destroy_all(& a) == 0);
+    CHECK(tm.size() == 2);
+
+    // Periodic timer of other owner keeps firing
+    auto ticks = fired.load();
+
+    for (int i = 0; i < 300 && fired == ticks; i++)
+        std::this_thread::sleep_for(milliseconds(10));
+
+    CHECK(fired > ticks);
+
+    // Running callbacks are waited for
+    std::atomic_bool in_callback {false};
+    std::atomic_bool returned {false};
+
+    tm.create(& c, milliseconds(0), milliseconds(10), [&] {
+        in_callback = true;
+        std::this_thread::sleep_for(milliseconds(50));
+        returned = true;
+    });
+
+    while (!in_callback)
+        std::this_thread::yield();
+
+    CHECK(tm.destroy_all(& c) == 1);
+    CHECK(returned);
+    CHECK(tm.size(& c) == 0);
+
+    // Owner's timers destroyed from the callback of one of them
+    std::atomic_bool destroyed {false};
+
+    tm.create(& d, seconds(60), seconds(0), [] {});
+    tm.create(& d, milliseconds(0), milliseconds(10), [& tm, & d, & destroyed] {
+        if (!destroyed) {
+            CHECK(tm.destroy_all(& d) == 2);
+            destroyed = true;
+        }
+    });
+
+    for (int i = 0; i < 300 && tm.size(& d) > 0; i++)
+        std::this_thread::sleep_for(milliseconds(10));
+
+    CHECK(destroyed);
+    CHECK(tm.size(& d) == 0);
+    CHECK(tm.destroy_all(& b) == 1);
+    CHECK(tm.size() == 1);
+}
+
+TEST_CASE("Timer owners") {
+    check_timer_owners<pfs::timer_pool<>>();
+    check_timer_owners<pooled_wheel_timer_pool>();
+    check_timer_owners<executor_timer_pool>();
+}
+
+// Per-request timeouts armed and cancelled by many threads
+template <typename TimerPool>
+void bench_arming (char const * name, int threads, bool posted)
+{
+    using namespace std::chrono;
+
+    int const count = 100000;
+    TimerPool tm;
+
+    ankerl::nanobench::Bench().epochs(3).epochIterations(1).batch(threads * count)
+        .unit("timer").run(std::string{"arm/cancel "} + (posted ? "posted" : "locked")
+            + ": " + name + " (" + std::to_string(threads) + " threads)", [&] {
+        std::vector<std::thread> workers;
+
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([& tm, posted, count] {
+                for (int i = 0; i < count; i++) {
+                    if (posted) {
+                        tm.post_destroy(tm.post_create(seconds(60), seconds(0), [] {}));
+                    } else {
+                        tm.destroy(tm.create(seconds(60), seconds(0), [] {}));
+                    }
+                }
+            });
+        }
+
+        for (auto & w: workers)
+            w.join();
+    });
+}
+
+// Lateness of 100 us periodic timer relative to its schedule
+template <typename TimerPool>
+void bench_jitter (char const * name, std::chrono::nanoseconds spin_threshold)
+{
+    using namespace std::chrono;
+    using clock_type = steady_clock;
+
+    int const count = 2000;
+    auto const period = microseconds(100);
+
+    TimerPool tm;
+    tm.set_spin_threshold(spin_threshold);
+
+    std::vector<nanoseconds> lateness;
+    lateness.reserve(count);
+
+    std::mutex mtx;
+    std::condition_variable done_cv;
+    auto start = clock_type::now() + milliseconds(1);
+    int n = 0;
+
+    auto id = tm.create(start, period, [&] {
+        auto now = clock_type::now();
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        if (n < count) {
+            lateness.push_back(duration_cast<nanoseconds>(now - (start + period * n)));
+
+            if (++n == count)
+                done_cv.notify_one();
+        }
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        done_cv.wait(lock, [&] { return n == count; });
+    }
+
+    tm.destroy(id);
+
+    std::sort(lateness.begin(), lateness.end());
+    nanoseconds total {0};
+
+    for (auto const & x: lateness)
+        total += x;
+
+    std::printf("jitter %-32s: mean %8.1f us, p50 %8.1f us, p99 %8.1f us, max %8.1f us\n"
+        , name
+        , duration<double, std::micro>(total).count() / count
+        , duration<double, std::micro>(lateness[count / 2]).count()
+        , duration<double, std::micro>(lateness[count * 99 / 100]).count()
+        , duration<double, std::micro>(lateness.back()).count());
+
+    CHECK(lateness.front().count() >= 0);
+}
+
+// Worker wakeups per second for 1000 heartbeat timers with different phases
+template <typename TimerPool>
+void bench_wakeups (char const * name, std::chrono::nanoseconds slack)
+{
+    using namespace std::chrono;
+
+    TimerPool tm;
+    tm.set_default_slack(slack);
+
+    for (int i = 0; i < 1000; i++)
+        tm.create(microseconds(100 * i), milliseconds(100), [] {});
+
+    std::this_thread::sleep_for(milliseconds(200));
+
+    // Rates are relative to measured interval, sleep may oversleep
+    auto start = steady_clock::now();
+    auto wakeups = tm.wakeups_count();
+    auto fired = tm.fired_count();
+    std::this_thread::sleep_for(seconds(1));
+
+    auto wakeups_delta = tm.wakeups_count() - wakeups;
+    auto fired_delta = tm.fired_count() - fired;
+    auto elapsed = duration<double>(steady_clock::now() - start).count();
+
+    std::printf("wakeups %-32s: %8.0f wakeups/s, %8.0f fires/s\n", name
+        , wakeups_delta / elapsed
+        , fired_delta / elapsed);
+}
+
+TEST_CASE("benchmark") {
+    for (int count: {10000, 100000, 1000000}) {
+        bench_timer_queue<pfs::timer_pool<>>("multiset", count);
+        bench_timer_queue<wheel_timer_pool>("timing wheel", count);
+    }
+
+    using std::chrono::microseconds;
+    using std::chrono::nanoseconds;
+
+    bench_jitter<pfs::timer_pool<>>("multiset (sleep)", nanoseconds(0));
+    bench_jitter<pfs::timer_pool<>>("multiset (spin 200 us)", microseconds(200));
+    bench_jitter<fine_wheel_timer_pool>("timing wheel 1 us (sleep)", nanoseconds(0));
+    bench_jitter<fine_wheel_timer_pool>("timing wheel 1 us (spin 200 us)", microseconds(200));
+
+#if defined(__linux__)
+    bench_jitter<timerfd_timer_pool>("multiset timerfd (sleep)", nanoseconds(0));
+#endif
+
+    using std::chrono::milliseconds;
+
+    bench_wakeups<pfs::timer_pool<>>("multiset (no slack)", nanoseconds(0));
+    bench_wakeups<pfs::timer_pool<>>("multiset (slack 10 ms)", milliseconds(10));
+    bench_wakeups<wheel_timer_pool>("timing wheel (no slack)", nanoseconds(0));
+    bench_wakeups<wheel_timer_pool>("timing wheel (slack 10 ms)", milliseconds(10));
+
+    for (bool posted: {false, true}) {
+        bench_arming<pfs::timer_pool<>>("multiset", 4, posted);
+
+#if defined(__linux__)
+        bench_arming<timerfd_timer_pool>("multiset timerfd", 4, posted);
+#endif
+    }
+}
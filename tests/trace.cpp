@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-modulus](https://github.com/semenovf/pfs-modulus) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/active_queue.hpp"
+#include "pfs/sigslot.hpp"
+#include "pfs/trace.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int count_of (std::string const & text, std::string const & pattern)
+{
+    int result = 0;
+
+    for (auto pos = text.find(pattern); pos != std::string::npos
+            ; pos = text.find(pattern, pos + 1)) {
+        result++;
+    }
+
+    return result;
+}
+
+// Identifiers of flow events with phase @a ph
+std::vector<unsigned long> flow_ids (std::string const & text, char ph)
+{
+    std::vector<unsigned long> result;
+    std::string pattern = std::string{"\"ph\":\""} + ph + "\"";
+
+    for (auto pos = text.find(pattern); pos != std::string::npos
+            ; pos = text.find(pattern, pos + 1)) {
+        auto id_pos = text.find("\"id\":", pos);
+        REQUIRE(id_pos != std::string::npos);
+        result.push_back(std::strtoul(text.c_str() + id_pos + 5, nullptr, 10));
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Tracer") {
+    auto & tracer = pfs::tracer::instance();
+
+    CHECK_FALSE(tracer.is_active());
+    CHECK(tracer.intern("") == 0);
+    CHECK(tracer.intern("span") == tracer.intern("span"));
+
+    tracer.start();
+    tracer.set_thread_name("main \"thread\"");
+
+    auto lbl = tracer.make_label("span", "module", 7);
+    auto start = tracer.now();
+    tracer.record_span("test", lbl, start, start + 1500);
+
+    // Events not fitting into buffer are dropped
+    tracer.start(4);
+
+    std::thread t {[& tracer, & lbl] {
+        for (int i = 0; i < 10; i++)
+            tracer.record_span("test", lbl, 0, 1000);
+    }};
+
+    t.join();
+    tracer.stop();
+
+    CHECK(tracer.size() == 5);
+    CHECK(tracer.dropped() == 6);
+
+    auto json = tracer.chrome_json();
+    CHECK(json.find("{\"traceEvents\":[") == 0);
+    CHECK(json.find("\"args\":{\"name\":\"main \\\"thread\\\"\"}") != std::string::npos);
+    CHECK(json.find("\"name\":\"span\",\"cat\":\"test\",\"ph\":\"X\"") != std::string::npos);
+    CHECK(json.find("\"dur\":1.500,\"args\":{\"module\":\"module\",\"api_id\":7}") != std::string::npos);
+    CHECK(count_of(json, "\"ph\":\"X\"") == 5);
+
+    // Events are not recorded when tracer is stopped
+    tracer.record_span("test", lbl, 0, 1000);
+    CHECK(tracer.size() == 5);
+
+    tracer.clear();
+    CHECK(tracer.size() == 0);
+    CHECK(tracer.dropped() == 0);
+
+    // Buffer of exited thread is reused once its events are discarded
+    auto buffers = tracer.buffer_count();
+    tracer.start();
+
+    std::thread t2 {[& tracer, & lbl] {
+        tracer.record_span("test", lbl, 0, 1000);
+    }};
+
+    t2.join();
+    tracer.stop();
+
+    CHECK(tracer.buffer_count() == buffers);
+    CHECK(tracer.size() == 1);
+
+    tracer.clear();
+
+    auto path = std::string{"trace_test.json"};
+    CHECK(tracer.dump(path));
+    std::remove(path.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Emission and queued delivery spans
+////////////////////////////////////////////////////////////////////////////////
+namespace t0 {
+
+using sigslot = pfs::sigslot<pfs::active_queue<>, std::mutex, pfs::profiling_policy>;
+
+class A : public sigslot::queued_slot_holder
+{
+public:
+    int counter = 0;
+
+public:
+    void slot (int n) { counter += n; }
+};
+
+class B : public sigslot::slot_holder
+{
+public:
+    int counter = 0;
+
+public:
+    void slot (int n) { counter += n; }
+};
+
+} // namespace t0
+
+TEST_CASE("Traced signals") {
+    using t0::sigslot;
+    using t0::A;
+    using t0::B;
+
+    auto & tracer = pfs::tracer::instance();
+    tracer.clear();
+
+    A a;
+    B b;
+    sigslot::signal<int> sig;
+    sig.stats()->set_trace_label("emit:1", "emitter", 1);
+
+    auto ha = sig.connect(& a, & A::slot);
+    auto hb = sig.connect(& b, & B::slot);
+    ha.stats()->set_trace_label("detect:1", "queued", 1);
+    hb.stats()->set_trace_label("detect:1", "direct", 1);
+
+    // Not traced
+    sig(1);
+    a.callback_queue().call_all();
+    CHECK(tracer.size() == 0);
+
+    tracer.start();
+
+    for (int i = 0; i < 3; i++)
+        sig(1);
+
+    std::thread consumer {[& a, & tracer] {
+        tracer.set_thread_name("consumer");
+        a.callback_queue().call_all();
+    }};
+
+    consumer.join();
+    tracer.stop();
+
+    CHECK(a.counter == 4);
+    CHECK(b.counter == 4);
+
+    auto json = tracer.chrome_json();
+    CHECK(count_of(json, "\"name\":\"emit:1\",\"cat\":\"emit\"") == 3);
+    CHECK(count_of(json, "\"cat\":\"execute\"") == 6);
+    CHECK(count_of(json, "\"module\":\"queued\"") == 3);
+    CHECK(count_of(json, "\"queue_wait_us\"") == 3);
+    CHECK(json.find("{\"name\":\"consumer\"}") != std::string::npos);
+
+    // Each queued delivery is bound by flow from enqueue to execution
+    auto starts = flow_ids(json, 's');
+    auto ends = flow_ids(json, 'f');
+    CHECK(starts.size() == 3);
+    CHECK(starts == ends);
+}